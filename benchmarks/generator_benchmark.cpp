@@ -0,0 +1,166 @@
+/*
+  Version: C++17
+  Compilation Instructions: cmake -S . -B build && cmake --build build, then ./build/generator_benchmark
+                            (or: g++ -std=c++17 -O2 -pthread -DDATASET_PROFILE -DDATASET_PROFILE_COUNTERS -I.. generator_benchmark.cpp)
+  Function: what generating datasets costs: every engine, every distribution and every thread count, then each DT's phases
+
+  Usage examples:
+  ===============
+  'generator_benchmark' uses 16M elements per dataset
+  'generator_benchmark 1000000' uses 1M elements per dataset
+*/
+
+#include "dataset.hpp"
+
+#include <chrono>    //Wall-clock timing
+#include <cstdlib>  //Contains 'std::strtoull()'
+#include <cerrno>  //Contains 'errno'
+
+namespace
+{
+    constexpr int REPETITIONS = 5;     //Regenerations per configuration (the fastest counts)
+    const char* const USAGE = "usage: generator_benchmark [elements per dataset (default 16777216)]\n";
+
+    //Elements per dataset: wholly a number, in range and positive (0 means the argument was no such number)
+    size_t elements(const std::string& text)
+    {
+        char* end = nullptr;
+        errno = 0;
+        const unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+
+        if (text.empty() or *end != '\0' or errno == ERANGE or text.find('-') != std::string::npos or parsed > std::numeric_limits<size_t>::max())
+            return 0;
+        return static_cast<size_t>(parsed);
+    }
+
+    //One line of a table: the fastest regeneration, and the hardware counters of the phase that did the work
+    template <typename Generate>
+    void measure(const std::string& name, const size_t size, const size_t bytes, const Phase phase, Generate generate)
+    {
+        double fastest = std::numeric_limits<double>::infinity();
+        resetProfile();
+
+        for(int r=0; r < REPETITIONS; r++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            generate(static_cast<std::uint64_t>(r));
+            fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        const PhaseProfile totals = profile(phase);
+        const double elements = static_cast<double>(totals.elements > 0 ? totals.elements : size * REPETITIONS);
+        std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1) << std::setw(12) << size / fastest / 1e6
+                  << std::setw(10) << std::setprecision(2) << bytes / fastest / 1e9 << std::setprecision(4);
+
+        //Without open counters (not built with them, or refused by the kernel) the misses read 0: say so rather than print a fake zero
+        if (totals.counted)
+            std::cout << std::setw(14) << totals.cacheMisses / elements << std::setw(14) << totals.branchMisses / elements << "\n";
+        else
+            std::cout << std::setw(14) << "n/a" << std::setw(14) << "n/a" << "\n";
+    }
+
+    //Table heading
+    void heading(const char* title)
+    {
+        std::cout << "\n" << std::left << std::setw(32) << title << std::right << std::setw(12) << "M elem/s" << std::setw(10) << "GB/s" << std::setw(14)
+                  << "LLC miss/el" << std::setw(14) << "br miss/el" << "\n";
+    }
+
+    //One engine, generating on a single thread
+    template <typename Engine>
+    void engine(const std::string& name, const size_t size)
+    {
+        DynamicDataset<std::uint32_t, DT::RANDOM, Engine> data(size, 0, 1u << 30, std::uint64_t(1));
+        measure(name, size, size * sizeof(std::uint32_t), Phase::RANDOM, [&](const std::uint64_t seed) { data.genNewData(0, 1u << 30, seed); });
+    }
+
+    //One distribution, generating on a single thread
+    void shape(const std::string& name, const size_t size, const Distribution& distribution)
+    {
+        DynamicDataset<double> data(size, 0.0, 1000.0, distribution, Parallel{1, 1});
+        measure(name, size, size * sizeof(double), Phase::SHAPED, [&](const std::uint64_t seed) { data.genNewData(0.0, 1000.0, distribution, Parallel{seed, 1}); });
+    }
+
+    //One DT, on every core, followed by how its time splits between the phases
+    template <DT dataT>
+    void phases(const std::string& name, const size_t size)
+    {
+        DynamicDataset<std::uint32_t, dataT> data(size, 0, 1u << 30, Parallel{1});
+        const bool distinct = dataT == DT::PERMUTATION or dataT == DT::DISTINCT;
+        const Phase outer = distinct ? Phase::DISTINCT : dataT == DT::FEW_UNIQUE ? Phase::UNIQUE : Phase::RANDOM;
+        measure(name, size, size * sizeof(std::uint32_t), outer, [&](const std::uint64_t seed) { data.genNewData(0, 1u << 30, Parallel{seed}); });
+
+        for(const Phase phase : {Phase::SORT, Phase::PERTURB, Phase::SHUFFLE})
+        {
+            const PhaseProfile inner = profile(phase);
+            const char* label = phase == Phase::SORT ? "sort" : phase == Phase::PERTURB ? "perturb" : "shuffle";
+            if (inner.calls > 0)
+                std::cout << "  " << label << ": " << std::setprecision(1) << 100 * inner.seconds / profile(outer).seconds << "% of the time\n";
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t size = argc > 1 ? elements(argv[1]) : size_t(1) << 24;
+    if (argc > 2 or size == 0)
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+#if not defined(DATASET_PROFILE)
+    std::cout << "(built without DATASET_PROFILE: no hardware counters or phase breakdown)\n";
+#endif
+
+    heading("Engine (1 thread)");
+    engine<std::mt19937>("std::mt19937", size);
+    engine<std::mt19937_64>("std::mt19937_64", size);
+    engine<std::minstd_rand>("std::minstd_rand", size);
+    engine<SplitMix64>("SplitMix64", size);
+    engine<Xoshiro256Plus>("Xoshiro256Plus", size);
+    engine<Xoshiro256StarStar>("Xoshiro256StarStar", size);
+    engine<Pcg64>("Pcg64", size);
+    engine<WyRand>("WyRand", size);
+    engine<Philox4x32>("Philox4x32", size);
+    {
+        //Parallel generation is always Philox streams (through the SIMD kernels)
+        DynamicDataset<std::uint32_t> data(size, 0, 1u << 30, Parallel{1, 1});
+        measure("Philox4x32 streams (Parallel)", size, size * sizeof(std::uint32_t), Phase::RANDOM, [&](const std::uint64_t seed) { data.genNewData(0, 1u << 30, Parallel{seed, 1}); });
+    }
+
+    heading("Distribution (double, 1 thread)");
+    {
+        DynamicDataset<double> data(size, 0.0, 1000.0, Parallel{1, 1});
+        measure("uniform (no Distribution)", size, size * sizeof(double), Phase::RANDOM, [&](const std::uint64_t seed) { data.genNewData(0.0, 1000.0, Parallel{seed, 1}); });
+    }
+    shape("uniform", size, Distribution::uniform(0, 1000));
+    shape("normal", size, Distribution::normal(500, 100));
+    shape("exponential", size, Distribution::exponential(0.01));
+    shape("zipf (10K ranks)", size, Distribution::zipf(10000, 1.1));
+    shape("power law", size, Distribution::powerLaw(2.5, 1));
+    shape("mixture (2 normals)", size, Distribution::mixture({{0.5, Distribution::normal(250, 50)}, {0.5, Distribution::normal(750, 50)}}));
+
+    heading("Threads (uint32_t RANDOM / SORTED)");
+    for(unsigned threads=1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        DynamicDataset<std::uint32_t> random(size, 0, 1u << 30, Parallel{1, threads});
+        DynamicDataset<std::uint32_t, DT::SORTED> sorted(size, 0, 1u << 30, Parallel{1, threads});
+        measure("RANDOM, threads = " + std::to_string(threads), size, size * sizeof(std::uint32_t), Phase::RANDOM, [&](const std::uint64_t seed) { random.genNewData(0, 1u << 30, Parallel{seed, threads}); });
+        measure("SORTED, threads = " + std::to_string(threads), size, size * sizeof(std::uint32_t), Phase::RANDOM, [&](const std::uint64_t seed) { sorted.genNewData(0, 1u << 30, Parallel{seed, threads}); });
+    }
+
+    heading("DT (uint32_t, every core)");
+    phases<DT::RANDOM>("RANDOM", size);
+    phases<DT::SORTED>("SORTED", size);
+    phases<DT::REVERSE_SORTED>("REVERSE_SORTED", size);
+    phases<DT::NEARLY_SORTED>("NEARLY_SORTED", size);
+    phases<DT::FEW_UNIQUE>("FEW_UNIQUE", size);
+    phases<DT::PERMUTATION>("PERMUTATION", size);
+    phases<DT::DISTINCT>("DISTINCT", size);
+    phases<DT::ORGAN_PIPE>("ORGAN_PIPE", size);
+    phases<DT::SAWTOOTH>("SAWTOOTH", size);
+    phases<DT::PUSH_FRONT>("PUSH_FRONT", size);
+    phases<DT::PUSH_BACK>("PUSH_BACK", size);
+    phases<DT::ALL_EQUAL>("ALL_EQUAL", size);
+}
@@ -0,0 +1,120 @@
+/*
+  Version: C++17
+  Compilation Instructions: cmake -S . -B build && cmake --build build, then ./build/sort_benchmark (or: g++ -std=c++17 -O2 -pthread -I.. sort_benchmark.cpp)
+  Function: the standard sorts and searches on every size, distribution type and range of the default sweep
+
+  Usage examples:
+  ===============
+  'sort_benchmark' prints a table
+  'sort_benchmark --csv results.csv --json results.json' also exports the results
+  'sort_benchmark --cache /tmp/datasets --seeds 10' maps the inputs from a dataset cache, on 10 seeds per configuration
+  'sort_benchmark --prefetch 2' generates the next 2 inputs in the background while each run is timed
+  'sort_benchmark --validate' also checks (untimed) that every output is sorted and a permutation of its input
+*/
+
+#include "dataset_benchmark.hpp"
+
+#include <fstream>   //Exports
+#include <cstdlib>  //Contains 'std::strtoull()'
+#include <cerrno>  //Contains 'errno'
+
+namespace
+{
+    //A count option (seeds, prefetched inputs), rejecting anything that isn't wholly a number in range: no silent 0 or wrapped -1
+    size_t count(const std::string& text, const char* name)
+    {
+        char* end = nullptr;
+        errno = 0;
+        const unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+
+        if (text.empty() or *end != '\0' or errno == ERANGE or text.find('-') != std::string::npos or parsed > std::numeric_limits<size_t>::max())
+            throw std::invalid_argument("invalid " + std::string(name) + "; '" + text + "' isn't a number in the range of its type.");
+        return static_cast<size_t>(parsed);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::string usage = "usage: " + std::string(argv[0]) + " [--csv file] [--json file] [--seeds n] [--prefetch n] [--cache directory] [--validate]\n";
+    Sweep<int> sweep;
+    sweep.ranges = {{0, 1000}, {0, 1 << 30}};
+    std::string csv, json;
+
+    //Options
+    for(int i=1; i < argc; i++)
+    {
+        const std::string option = argv[i];
+        if (option == "--validate")
+        {
+            sweep.validate = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+        {
+            std::cerr << usage;
+            return 1;
+        }
+
+        const char* value = argv[++i];
+        try
+        {
+            if (option == "--csv")
+                csv = value;
+            else if (option == "--json")
+                json = value;
+            else if (option == "--seeds")
+            {
+                sweep.seeds = count(value, "seed count");
+                if (sweep.seeds == 0)
+                    throw std::invalid_argument("invalid seed count; every configuration needs at least one input.");
+            }
+            else if (option == "--prefetch")
+                sweep.prefetch = count(value, "prefetch depth");
+#if defined(DATASET_POSIX_IO)
+            else if (option == "--cache")
+                sweep.cache = value;
+#endif
+            else
+            {
+                std::cerr << "unknown option '" << option << "'\n" << usage;
+                return 1;
+            }
+        }
+        catch (const std::invalid_argument& error)
+        {
+            std::cerr << argv[0] << ": " << error.what() << "\n" << usage;
+            return 1;
+        }
+    }
+
+    Benchmark<int> bench(sweep);
+    bench.run("std::sort", [](int* data, size_t size) { std::sort(data, data + size); });
+    bench.run("std::stable_sort", [](int* data, size_t size) { std::stable_sort(data, data + size); });
+    bench.run("std::make+sort_heap", [](int* data, size_t size) { std::make_heap(data, data + size); std::sort_heap(data, data + size); });
+
+    //Searches only make sense on sorted inputs: one lookup per element, of elements at scattered positions
+    Sweep<int> sorted = sweep;
+    sorted.types = {DT::SORTED};
+    bench.run("std::lower_bound", [](int* data, size_t size)
+    {
+        size_t positions = 0;
+        for(size_t i=0; i < size; i++)
+            positions += static_cast<size_t>(std::lower_bound(data, data + size, data[i * 40503 % size]) - data);
+        return positions;
+    }, sorted);
+
+    bench.print();
+
+    if (not csv.empty())
+    {
+        std::ofstream file(csv);
+        bench.writeCSV(file);
+    }
+
+    if (not json.empty())
+    {
+        std::ofstream file(json);
+        bench.writeJSON(file);
+    }
+}
@@ -12,259 +12,8103 @@
   'Dataset<int,20, DT::REVERSE_SORTED> array' is an array of 20 random, sorted integers
   'Dataset<int,20, DT::NEARLY_SORTED> array' is an array of 20, nearly-sorted integers
   'Dataset<int,20, DT::FEW_UNIQUE> array' is an array of 20, random, few-unique integers
+  'Dataset<int,20, DT::PERMUTATION> array' is the integers 0 to 19 in random order
+  'Dataset<int,20, DT::DISTINCT> array' is an array of 20 different random integers
+  'Dataset<int,20, DT::ORGAN_PIPE> array' is an array of 20 random integers rising, then falling (also SAWTOOTH, PUSH_FRONT, PUSH_BACK, ALL_EQUAL)
+
+  'DynamicDataset<int> array(n)' is a heap-allocated array of n random integers (n is given at runtime)
+  'DynamicDataset<int, DT::SORTED> array(n, 0, 1000, Memory::HUGE_PAGES)' is n random, sorted integers backed by huge pages
+  'DynamicDataset<int> array(n, arena)' is n random integers carved out of a user-supplied 'Arena'
+  'DynamicDataset<int> array(n, 0, 1000, Parallel{seed, 64})' is n random integers generated by 64 threads (same output for any thread count)
+  'Dataset<int,20> array(0, 1000, seed)' is an array of 20 random integers that is the same every time for the same seed
+  'constexpr Dataset<int,20, DT::SORTED> array(0, 1000, CompileTime{seed})' is an array of 20 random, sorted integers computed by the compiler
+  'Dataset<int,20, DT::RANDOM, Xoshiro256StarStar> array' is an array of 20 random integers drawn from xoshiro256** instead of the Mersenne Twister
+  'DatasetView<int> view(n, 0, 1000, seed)' is n random integers computed on demand (never stored; same elements as the Parallel{seed} dataset)
+  'DatasetProducer<int, DT::SORTED> blocks(n, 0, 1000, seed)' emits n sorted integers 256KB at a time through 'blocks.nextBlock(buffer)'
+  'DatasetPipeline<int> ring(n, 0, 1000, Parallel{seed})' keeps datasets of n random integers ready ahead of 'ring.next()', refilled in the background
+*/
+
+//Header guard
+#pragma once
+
+//Native C++ Libraries
+#include <iostream>          //Input/output
+#include <iomanip>          //Formatting floats
+#include <random>          //Random number generators
+#include <algorithm>      //Sorting functions
+#include <functional>    //'std::less' and 'std::greater' comparators
+#include <type_traits>  //Type-info for type-guarding
+#include <stdexcept>   //Contains 'std::invalid_argument'
+#include <new>        //Aligned 'operator new' and 'std::bad_alloc'
+#include <limits>    //Contains 'std::numeric_limits'
+#include <array>      //Philox output blocks
+#include <vector>    //Worker thread list
+#include <thread>   //Parallel generation
+#include <memory>    //Shared state of 'DatasetView' copies
+#include <atomic>   //'DatasetView' identities
+#include <iterator>  //Iterator tags
+#include <utility>  //Contains 'std::pair'
+#include <optional> //Views of a 'DatasetProducer'
+#include <string>     //File paths
+#include <future>    //Background writes and generation
+#include <mutex>              //'DatasetPipeline' ring
+#include <condition_variable>  //'DatasetPipeline' workers
+#include <exception>          //Generation errors carried to the consumer
+#include <charconv> //Contains 'std::to_chars()'
+#include <system_error>  //I/O errors
+#include <typeinfo>     //Engine names for the dataset cache
+#include <numeric>     //Contains 'std::gcd()' and 'std::iota()'
+
+//Native C Libraries
+#include <cstddef>     //Contains 'size_t'
+#include <cstdint>    //Fixed-width integers for the random number engines
+#include <cmath>     //Contains 'sqrt()'
+#include <cstring>  //Contains 'memcpy()'
+#include <cerrno>  //Contains 'errno'
+#include <cassert> //Checks on 'munmap()'
+#include <cstdio> //Contains 'snprintf()' and 'rename()'
+
+//Operating system libraries (huge page support, file output, dataset cache)
+#if defined(__unix__) or defined(__APPLE__)
+#define DATASET_POSIX_IO 1
+#include <sys/mman.h>   //Contains 'mmap()', 'munmap()' and 'madvise()'
+#include <sys/stat.h>  //Contains 'fstat()'
+#include <fcntl.h>    //Contains 'open()' and 'fcntl()'
+#include <unistd.h>  //Contains 'write()', 'close()' and 'ftruncate()'
+#endif
+
+//NUMA placement (raw system calls, so there is no libnuma dependency)
+#if defined(__linux__)
+#define DATASET_NUMA 1
+#include <linux/mempolicy.h>   //Contains 'MPOL_INTERLEAVE', 'MPOL_BIND' and 'MPOL_PREFERRED'
+#include <sys/syscall.h>      //Contains 'SYS_mbind' and 'SYS_get_mempolicy'
+#endif
+
+//SIMD intrinsics (define 'DATASET_NO_SIMD' to always use the portable kernels)
+#if not defined(DATASET_NO_SIMD) and (defined(__x86_64__) or defined(__i386__)) and (defined(__GNUC__) or defined(__clang__))
+#define DATASET_X86_SIMD 1      //AVX2 + AVX-512, chosen at runtime
+#include <immintrin.h>
+#elif not defined(DATASET_NO_SIMD) and defined(__aarch64__)
+#define DATASET_NEON_SIMD 1   //NEON is part of every AArch64 CPU
+#include <arm_neon.h>
+#endif
+
+//Generation profiling (define 'DATASET_PROFILE' to time the generators' phases, plus 'DATASET_PROFILE_COUNTERS' for hardware counters on Linux)
+#if defined(DATASET_PROFILE)
+#include <chrono>    //Phase timing
+#define DATASET_PHASE(phase, elements, bytes) const dataset_detail::PhaseTimer phaseTimer(phase, elements, bytes)
+#if defined(DATASET_PROFILE_COUNTERS) and defined(__linux__)
+#define DATASET_PERF_EVENTS 1
+#include <linux/perf_event.h>   //Contains 'perf_event_attr'
+#include <sys/syscall.h>       //Contains 'SYS_perf_event_open'
+#include <unistd.h>           //Contains 'syscall()', 'read()' and 'close()'
+#endif
+#else
+#define DATASET_PHASE(phase, elements, bytes) static_cast<void>(0)     //Nothing is measured (or even evaluated)
+#endif
+
+
+//Different types of datasets (as an enum class for type safety); 'PERMUTATION' is the values min, min + 1, ... in random order, 'DISTINCT' is
+//'size' different values of [min, max] in random order (both integral only). The rest are the worst cases of sorting benchmarks: 'ORGAN_PIPE' rises
+//(sorted first half) then falls (reverse sorted second half), 'SAWTOOTH' is {sqrt(size)} sorted runs in a row, 'PUSH_FRONT' is sorted except for the
+//smallest element (moved to the end), 'PUSH_BACK' is sorted except for the largest (moved to the front), and 'ALL_EQUAL' is one random value repeated
+enum class DT { RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED, FEW_UNIQUE, PERMUTATION, DISTINCT, ORGAN_PIPE, SAWTOOTH, PUSH_FRONT, PUSH_BACK, ALL_EQUAL };
+
+//Where the storage of a 'DynamicDataset' comes from ('ARENA', 'MAPPED' and 'NUMA' are set automatically when constructed from an 'Arena', a 'Cache' or a 'Numa')
+enum class Memory { HEAP, HUGE_PAGES, ARENA, MAPPED, NUMA };
+
+//NUMA placement of a dataset's pages: on the node of the worker thread that fills them, spread round-robin over every allowed node, or all on one node
+enum class Placement { FIRST_TOUCH, INTERLEAVE, BIND };
+
+//NUMA settings (Linux; elsewhere, and on kernels without NUMA support, the pages are ordinary memory)
+struct Numa
+{
+    Placement placement = Placement::FIRST_TOUCH;     //How the pages are placed
+    int node = 0;                                    //BIND: the node (see 'numaNodes()')
+};
+
+//NUMA nodes this process may allocate on ({0} where there is no NUMA support)
+std::vector<int> numaNodes();
+
+//Alignment (in bytes) of every dataset's internal array, so SIMD kernels can use aligned loads/stores
+constexpr size_t DATASET_ALIGNMENT = 64;
+
+//Parallel generation settings: the seed decides the data, the thread count (0 = all cores) only decides how fast it is made (always Philox4x32 streams, whatever the dataset's engine)
+struct Parallel
+{
+    std::uint64_t seed;
+    unsigned threads = 0;
+};
+
+//Shard settings: one node's part of a dataset of 'total' elements cut into 'count' contiguous shards. Shard 'index' holds exactly the elements
+//'shardRange()' gives of 'DynamicDataset<T, dataT>(total, min, max, Parallel{seed})', so N nodes generate one dataset between them without talking
+struct Shard
+{
+    size_t total;      //Elements of the whole dataset
+    size_t index;     //This shard (0 to count - 1)
+    size_t count;    //Shards in all
+};
+
+//First and one past the last element of a shard (the first 'total % count' shards hold one element more than the others; 'total' must be at
+//least 'count', so no shard is empty)
+std::pair<size_t, size_t> shardRange(const Shard&);
+
+//Compile-time generation settings: a 'constexpr' dataset built from them is computed by the compiler (always SplitMix64, whatever the dataset's engine)
+struct CompileTime
+{
+    std::uint64_t seed;
+};
+
+//A fresh random seed (cheap: drawn from this thread's cached engine); log it to reproduce a dataset later
+std::uint64_t randomSeed();
+
+//Phases of generation a 'DATASET_PROFILE' build measures (they nest: a generator's time includes the sorts and perturbations it runs)
+enum class Phase { RANDOM, UNIQUE, SHAPED, SORT, PERTURB, DISTINCT, SHUFFLE };
+
+//What a phase has cost, summed over every call on every thread since 'resetProfile()' (all zero unless 'DATASET_PROFILE' is defined)
+struct PhaseProfile
+{
+    std::uint64_t calls = 0;            //Times the phase ran
+    double seconds = 0;                //Wall time
+    std::uint64_t elements = 0;       //Elements of the arrays it filled or reordered
+    std::uint64_t bytes = 0;         //Bytes of the arrays it filled or reordered
+    std::uint64_t cacheMisses = 0;  //Hardware counters, worker threads included ('DATASET_PROFILE_COUNTERS' on Linux; 0 where perf events are not allowed)
+    std::uint64_t branchMisses = 0;
+    bool counted = false;          //Whether every call was measured by open hardware counters (if not, the misses mean nothing)
+
+    double elementsPerSecond() const noexcept;    //Throughput
+};
+
+PhaseProfile profile(const Phase);     //A phase's totals so far
+void resetProfile() noexcept;         //Count every phase from zero again
+
+//How 'perturb()' disturbs (sorted) data: {sqrt(sqrt(size))} random swaps (what NEARLY_SORTED does), a share of the elements swapped, every element
+//shuffled within a window, or neighbouring runs trading places
+enum class Perturbation { FEW_SWAPS, SWAPS, WINDOW, RUNS };
+
+//Disorder settings for 'perturb()' (every model but 'FEW_SWAPS' and far-reaching 'SWAPS' is one streaming pass that only moves elements within a small window)
+struct Disorder
+{
+    Perturbation model = Perturbation::FEW_SWAPS;     //Which kind of disorder
+    double fraction = 0;                             //SWAPS: share of the elements that are swapped (0 to 1)
+    size_t window = 0;                              //SWAPS: farthest a swap reaches (0 = anywhere); WINDOW: farthest any element moves; RUNS: longest run
+};
+
+//File formats for 'write()'
+enum class Format { BINARY, TEXT, PACKED };     //Raw little-endian values, decimal text (see 'TextFormat'), or compressed blocks (see 'PackedReader')
+
+//Framing of text output
+enum class Framing { PLAIN, CSV, JSON };    //Values separated by spaces, comma-separated rows, or a JSON array
+
+//How 'print()' and text 'write()' lay the values out
+struct TextFormat
+{
+    Framing framing = Framing::PLAIN;     //Plain, CSV or JSON
+    std::string separator = "";          //Between values on a line (empty = the framing's own: " ", "," or ", ")
+    size_t lineWidth = 0;               //Values per line (0 = all on one line)
+};
+
+//How 'write()' sends a dataset to a file or pipe
+struct Output
+{
+    Format format = Format::BINARY;     //Binary, text or packed
+    bool direct = false;               //Open files with 'O_DIRECT' where supported (skips the page cache, for TB-scale files)
+    size_t buffer = 1 << 20;          //Bytes per write; one buffer is filled while the other is being written
+    TextFormat text = TextFormat();  //Layout of 'Format::TEXT'
+};
+
+//On-disk cache of generated datasets: a dataset with the same type, size, distribution, range, seed and engine is memory-mapped from its file
+//(copy-on-write) instead of being generated again
+struct Cache
+{
+    std::string directory;      //Where the cached files live (must exist)
+    bool verify = false;       //Check the stored checksum on every load (reads the whole file)
+};
+
+
+/*
+    +----------------------------+
+    |           Arena            |
+    +----------------------------+
+*/
+
+//Arena: a user-supplied block of memory that datasets are carved out of (bump allocation; the user owns and frees the block)
+class Arena
+{
+    // DATA MEMBERS //
+    private:
+        unsigned char* memory;     //Start of the user's block
+        size_t capacity;          //Size of the block (in bytes)
+        size_t offset;           //Bytes handed out so far
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        Arena(void*, const size_t) noexcept;     //Wrap a block of memory of the given size (in bytes)
+
+        //Public methods
+        void* allocate(const size_t, const size_t = DATASET_ALIGNMENT);   //Carve an aligned chunk out of the arena (throws 'std::bad_alloc' when exhausted)
+        void reset() noexcept;                                           //Hand out the whole block again (invalidates every dataset built on it)
+        size_t used() const noexcept;                                   //Bytes handed out so far (including alignment padding)
+        size_t available() const noexcept;                             //Bytes left in the arena
+};
+
+
+/*
+    +----------------------------+
+    |   Random Number Engines    |
+    +----------------------------+
+*/
+
+//Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"): a counter-based engine, so any position of any stream can be computed directly
+class Philox4x32
+{
+    // DATA MEMBERS //
+    private:
+        std::uint64_t key;                        //Seed
+        std::uint64_t stream;                    //Upper half of the counter (independent streams per seed)
+        std::uint64_t counter;                  //Lower half of the counter (position in the stream, in blocks of 4 outputs)
+        std::array<std::uint32_t, 4> buffer;   //Current block of outputs
+        unsigned used;                        //Outputs of 'buffer' already returned
+
+    // FUNCTION MEMBERS //
+    public:
+        using result_type = std::uint32_t;
+
+        //Public special methods
+        explicit Philox4x32(const std::uint64_t = 0, const std::uint64_t = 0) noexcept;   //seed, stream
+
+        //Public methods
+        result_type operator()() noexcept;             //Next output of the stream
+        void discard(unsigned long long) noexcept;    //Skip outputs in O(1)
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        //The counter-based function itself: block 'counter' of stream 'stream' under key 'key'
+        static std::array<std::uint32_t, 4> block(const std::uint64_t, const std::uint64_t, const std::uint64_t) noexcept;
+};
+
+//SplitMix64 (Steele, Lea & Flood): one word of state, and the usual way to expand a 64-bit seed into the state of the engines below
+class SplitMix64
+{
+    // DATA MEMBERS //
+    private:
+        std::uint64_t state;     //Weyl sequence
+
+    // FUNCTION MEMBERS //
+    public:
+        using result_type = std::uint64_t;
+
+        //Public special methods
+        constexpr explicit SplitMix64(const std::uint64_t = 0) noexcept;   //seed
+
+        //Public methods
+        constexpr result_type operator()() noexcept;     //Next output (usable in constant expressions)
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+};
+
+//Output functions of the xoshiro256 family
+enum class Scrambler { PLUS, STARSTAR };
+
+//xoshiro256+ / xoshiro256** (Blackman & Vigna, "Scrambled linear pseudorandom number generators"): 256 bits of state, jump-ahead by 2^128 or 2^192 outputs
+template <Scrambler scrambler>
+class Xoshiro256
+{
+    // DATA MEMBERS //
+    private:
+        std::array<std::uint64_t, 4> state;
+
+    // FUNCTION MEMBERS //
+    private:
+        void leap(const std::array<std::uint64_t, 4>&) noexcept;     //Apply a jump polynomial
+
+    public:
+        using result_type = std::uint64_t;
+
+        //Public special methods
+        explicit Xoshiro256(const std::uint64_t = 0) noexcept;   //seed (expanded with SplitMix64)
+
+        //Public methods
+        result_type operator()() noexcept;     //Next output
+        void jump() noexcept;                 //Advance by 2^128 outputs (one non-overlapping stream per thread)
+        void longJump() noexcept;            //Advance by 2^192 outputs (one non-overlapping stream per machine)
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+};
+
+using Xoshiro256Plus = Xoshiro256<Scrambler::PLUS>;              //Fastest; only the low bits are weak, and range reduction uses the high bits
+using Xoshiro256StarStar = Xoshiro256<Scrambler::STARSTAR>;     //All bits are good
+
+//PCG64 (O'Neill, PCG-XSL-RR 128/64): a 128-bit LCG with a permuted 64-bit output and 2^127 selectable streams
+class Pcg64
+{
+    // DATA MEMBERS //
+    private:
+        std::uint64_t high, low;                  //128-bit state
+        std::uint64_t incrementHigh, incrementLow;   //128-bit (odd) increment, which picks the stream
+
+    // FUNCTION MEMBERS //
+    private:
+        void step() noexcept;     //state = state * multiplier + increment (mod 2^128)
+
+    public:
+        using result_type = std::uint64_t;
+
+        //Public special methods
+        explicit Pcg64(const std::uint64_t = 0, const std::uint64_t = 0) noexcept;   //seed, stream
+
+        //Public methods
+        result_type operator()() noexcept;     //Next output
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+};
+
+//WyRand (Wang Yi): one word of state, a Weyl sequence folded through a 64x64 -> 128 bit multiply
+class WyRand
+{
+    // DATA MEMBERS //
+    private:
+        std::uint64_t state;     //Weyl sequence
+
+    // FUNCTION MEMBERS //
+    public:
+        using result_type = std::uint64_t;
+
+        //Public special methods
+        explicit WyRand(const std::uint64_t = 0) noexcept;   //seed
+
+        //Public methods
+        result_type operator()() noexcept;     //Next output
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+};
+
+
+/*
+    +----------------------------+
+    |       Distributions        |
+    +----------------------------+
+*/
+
+//Shapes a 'Distribution' can have
+enum class Shape { UNIFORM, NORMAL, EXPONENTIAL, ZIPF, POWER_LAW, MIXTURE };
+
+//Distribution: a value distribution chosen at runtime, for 'genNewData()' and the 'DynamicDataset' constructors (instead of uniform values). The samplers are
+//table driven (256-layer ziggurats for normal and exponential values, Vose alias tables for Zipf ranks and mixture weights), built once when the
+//distribution is made and shared by its copies, so reusing one distribution across datasets costs nothing
+class Distribution
+{
+    // DATA MEMBERS //
+    private:
+        struct Table;                               //Alias table (and the components of a mixture)
+        Shape shape;                               //Which shape
+        double first, second;                     //Parameters (see the factories)
+        std::shared_ptr<const Table> table;      //'ZIPF' and 'MIXTURE' only
+
+    // FUNCTION MEMBERS //
+    private:
+        Distribution(const Shape, const double, const double, std::shared_ptr<const Table> = nullptr) noexcept;
+
+    public:
+        //Factories
+        static Distribution uniform(const double, const double);         //minimum, maximum
+        static Distribution normal(const double, const double);         //mean, standard deviation
+        static Distribution exponential(const double);                 //rate (the mean is 1 / rate)
+        static Distribution zipf(const size_t, const double);         //ranks 1..n, exponent s (rank k has weight 1 / k^s; the table holds n entries)
+        static Distribution powerLaw(const double, const double);    //exponent (> 1), smallest value (> 0): Pareto values with density ~ x^-exponent
+        static Distribution mixture(const std::vector<std::pair<double, Distribution>>&);    //(weight, component) pairs, e.g. two normals for a bimodal shape
+
+        //Public methods
+        template <typename Engine>
+        double operator()(Engine&) const;    //One sample
+        Shape kind() const noexcept;        //Which shape
+};
+
+//Collisions: keys that all land in the same bucket of a hash table ('hash(key) % buckets == bucket'), for the 'genNewData()' and 'DynamicDataset' overloads
+//of DISTINCT 64-bit datasets. The hash has to be a bijection of 64-bit values with a known inverse: the keys are then computed from the hash values
+//they need (bucket, bucket + buckets, bucket + 2 * buckets...), never searched for
+class Collisions
+{
+    public:
+        using Hash = std::function<std::uint64_t(std::uint64_t)>;
+
+    // DATA MEMBERS //
+    private:
+        Hash hash, inverse;              //The table's hash, and the function that undoes it
+        std::uint64_t buckets, bucket;  //The table's bucket count, and the bucket every key lands in
+
+    // FUNCTION MEMBERS //
+    public:
+        Collisions(Hash, Hash, const std::uint64_t, const std::uint64_t = 0);    //hash, inverse, bucket count, bucket (checks that 'inverse' undoes 'hash')
+
+        //Factories (hashes real tables use)
+        static Collisions identity(const std::uint64_t, const std::uint64_t = 0);                            //The key itself ('std::hash' of integers in libstdc++ and libc++)
+        static Collisions multiplicative(const std::uint64_t, const std::uint64_t, const std::uint64_t = 0);   //key * multiplier (odd, e.g. 0x9E3779B97F4A7C15), bucket count, bucket
+        static Collisions murmur(const std::uint64_t, const std::uint64_t = 0);                              //MurmurHash3's 64-bit finalizer ('fmix64')
+
+        //Public methods
+        std::uint64_t key(const std::uint64_t) const;    //The key with the k-th colliding hash value (bucket + k * buckets)
+        std::uint64_t last() const noexcept;            //The largest k (there are last() + 1 colliding keys)
+};
+
+
+/*
+    +----------------------------+
+    |    Generation Algorithms   |
+    +----------------------------+
+*/
+
+//Implementation details shared by every dataset type (not part of the public interface)
+namespace dataset_detail
+{
+    //Element types: 128-bit integers are recognised even in strict ISO mode (where 'std::is_integral' says no)
+    template <typename T>
+    struct isWide : std::false_type {};
+
+#if defined(__SIZEOF_INT128__)
+    template <>
+    struct isWide<__int128> : std::true_type {};
+
+    template <>
+    struct isWide<unsigned __int128> : std::true_type {};
+#endif
+
+    template <typename T>
+    constexpr bool isReal = std::is_floating_point<T>::value;                          //float, double, long double
+
+    template <typename T>
+    constexpr bool isElement = std::is_integral<T>::value or isReal<T> or isWide<T>::value;  //Anything a dataset can hold
+
+    template <typename T>
+    constexpr bool isSigned = std::is_signed<T>::value or (isWide<T>::value and T(-1) < T(0));
+
+    //The unsigned type (of integers) that range arithmetic wraps in
+    template <typename T, typename = void>
+    struct unsignedOf { using type = typename std::make_unsigned<T>::type; };
+
+#if defined(__SIZEOF_INT128__)
+    template <typename T>
+    struct unsignedOf<T, typename std::enable_if<isWide<T>::value>::type> { using type = unsigned __int128; };
+#endif
+
+    template <typename T>
+    constexpr void checkRange(const T, const T);     //Throws 'std::invalid_argument' unless [min, max] is a valid range
+
+    template <typename T>
+    class KeyMap;                                    //Sorted floats and 128-bit integers: generated as sorted 64-bit keys, then mapped back in order
+
+    template <typename T, typename Engine>
+    T drawValue(const T, const T, Engine&);         //One uniform value in [min, max] (or [min, max) for floating point)
+
+    template <typename U>
+    constexpr U scaleWide(const U, const U) noexcept;   //'scale()' for 128-bit draws (range 0 = all 2^128 values)
+
+    double unitDouble(const std::uint64_t) noexcept;    //[0, 1) from the top 52 bits, through the mantissa (no division)
+    float unitFloat(const std::uint32_t) noexcept;     //[0, 1) from the top 23 bits, through the mantissa
+
+    template <DT dataT, typename T, typename Engine>
+    void genRandomData(T*, const size_t, const T, const T, Engine&);     //Generate a new dataset, which is sorted if needed
+
+    template <typename T, typename Engine>
+    void genUniqueData(T*, const size_t, const T, const T, Engine&);    //Generate a new dataset of few-unique data
+
+    template <DT dataT, typename T>
+    void genRandomDataParallel(T*, const size_t, const T, const T, const Parallel);   //Generate a new dataset on several threads (output depends only on the seed)
+
+    template <typename T>
+    void genUniqueDataParallel(T*, const size_t, const T, const T, const Parallel);   //Generate few-unique data on several threads (output depends only on the seed)
+
+    template <DT dataT, typename T>
+    constexpr void genConstantData(T*, const size_t, const T, const T, const std::uint64_t);   //Generate a new dataset of any DT in a constant expression (same output at runtime)
+
+    template <typename T>
+    constexpr T constantValue(const T, const T, SplitMix64&) noexcept;   //'drawValue()' without the standard distributions, which aren't 'constexpr'
+
+    template <bool descending, typename T>
+    constexpr void heapSort(T*, const size_t) noexcept;    //In-place sort for constant expressions ('std::sort' only is from C++20)
+
+    template <typename T>
+    constexpr void exchange(T&, T&) noexcept;             //'std::swap' for constant expressions (also C++20)
+
+    constexpr size_t rootOf(const size_t) noexcept;      //Integer square root, rounded down
+
+    template <typename T>
+    void uniqueSamples(std::vector<T>&, const size_t, const T, const T, const std::uint64_t);    //A seed's few-unique sample table ({sqrt(size)} values), into a vector
+
+    template <typename T>
+    void fillUnique(T*, const std::uint64_t, const size_t, const std::vector<T>&, const std::uint64_t);   //Few-unique elements [first, first + count), picked from the sample table
+
+    template <typename T>
+    class SortedPlan;                                 //How many elements of a sorted dataset fall in each slice ("bucket") of the value range
+
+    template <bool descending, typename T, typename Key, typename Source>
+    void fillSorted(T*, const size_t, const size_t, const SortedPlan<Key>&, Source, const KeyMap<T>&);    //Positions [first, first + count) of a sorted (or reverse sorted) dataset
+
+    template <typename T, typename Draw>
+    void fillBucket(T*, const size_t, const T, const std::uint64_t, const bool, Draw&);   //One bucket's elements, in order
+
+    template <typename T>
+    void seededPlan(SortedPlan<T>&, const size_t, const T, const T, const std::uint64_t);    //The bucket sizes for a seed (every split has its own sub-stream), into a plan
+
+    class BucketDraws;                                //A seed's draws for one bucket (generated in bulk)
+
+    template <typename T>
+    constexpr void checkDistinct(const DT, const size_t, const T, const T);    //Throws 'std::invalid_argument' unless the range holds 'size' different values (PERMUTATION, DISTINCT)
+
+    template <DT dataT, typename T, typename Engine>
+    void genDistinctData(T*, const size_t, const T, const T, Engine&);     //Generate a new dataset of different values (PERMUTATION or DISTINCT)
+
+    template <DT dataT, typename T>
+    void genDistinctDataParallel(T*, const size_t, const T, const T, const Parallel);    //Generate different values on several threads (output depends only on the seed)
+
+    template <typename T>
+    void seededChoice(SortedPlan<T>&, const size_t, const T, const T, const std::uint64_t);    //DISTINCT: how many chosen values fall in each bucket, for a seed (hypergeometric splits)
+
+    template <typename T, typename Draw>
+    void sampleBucket(T*, const size_t, const T, const std::uint64_t, Draw&);   //Floyd's algorithm: 'count' different values of [lowest, lowest + width), in the order they are chosen
+
+    template <typename T, typename Engine>
+    void fisherYates(T*, const size_t, Engine&);    //Shuffle in place
+
+    template <typename T, typename Source>
+    void shuffleParallel(T*, const size_t, const std::uint64_t, const unsigned, Source);    //Random order of the elements 'source()' makes, on several threads (same output for any thread count)
+
+    constexpr bool isPattern(const DT) noexcept;            //The worst-case patterns (ORGAN_PIPE, SAWTOOTH, PUSH_FRONT, PUSH_BACK, ALL_EQUAL)
+    constexpr size_t toothLength(const size_t) noexcept;   //SAWTOOTH: elements per run ({sqrt(size)}, at least 1)
+
+    template <DT dataT, typename T, typename Engine>
+    void genPatternData(T*, const size_t, const T, const T, Engine&);     //Generate a worst-case pattern (from sorted runs, in O(n))
+
+    template <DT dataT, typename T>
+    void genPatternDataParallel(T*, const size_t, const T, const T, const Parallel);    //Generate a worst-case pattern on several threads (output depends only on the seed)
+
+    template <DT dataT, typename T>
+    void arrangeData(T*, const size_t);     //Sort any values into a pattern (for values that don't come from the O(n) sorted generators)
+
+    std::uint64_t runSeed(const std::uint64_t, const std::uint64_t) noexcept;    //ORGAN_PIPE, SAWTOOTH: the seed of run r (each run is a sorted dataset of its own)
+
+    template <typename Sort>
+    void antiQuicksort(std::vector<size_t>&, const size_t, Sort);    //McIlroy's adversary: the ranks that drive 'sort' to its worst case
+
+    constexpr std::uint64_t inverseOdd(const std::uint64_t) noexcept;    //Inverse of an odd number modulo 2^64 (undoes a multiplicative hash)
+
+    template <typename T, typename Engine>
+    void perturbData(T*, const size_t, Engine&);    //Swap {sqrt(sqrt(size))} random pairs (NEARLY_SORTED)
+
+    template <typename T, typename Engine>
+    void perturbData(T*, const size_t, const Disorder&, Engine&);    //Apply a disorder model
+
+    template <typename T>
+    void fillStream(T*, const std::uint64_t, const size_t, const T, const T, const std::uint64_t, const std::uint64_t);   //Elements [first, first + count) of a seeded stream
+
+    template <typename T>
+    void fillIntegers(T*, const std::uint64_t, const size_t, const T, const T, const std::uint64_t, const std::uint64_t);   //'fillStream()' for integers up to 64 bits
+
+    constexpr std::uint64_t scale(const std::uint64_t, const std::uint64_t) noexcept;    //Map a 64-bit draw onto [0, range) with a multiply-shift (range 0 = all 2^64 values)
+
+    constexpr std::uint64_t multiply64(const std::uint64_t, const std::uint64_t, std::uint64_t&) noexcept;   //Full 64x64 -> 128 bit product (returns the low half)
+    constexpr std::uint64_t rotl(const std::uint64_t, const int) noexcept;                       //Rotate left
+    constexpr std::uint64_t rotr(const std::uint64_t, const int) noexcept;                      //Rotate right
+
+    template <typename Engine>
+    Engine& threadEngine();                           //This thread's engine for unseeded generation (seeded once from 'std::random_device')
+
+    class SeedSequence;                              //'std::seed_seq' of two 32-bit words, without its heap allocation
+
+    template <typename Engine>
+    Engine seededEngine(const std::uint64_t);        //An engine whose whole state comes from a 64-bit seed
+
+    template <typename Engine>
+    std::uint64_t draw64(Engine&);                   //64 random bits from any engine
+
+    //Anything that looks like a random number engine ('result_type' + 'operator()'), so seeds and engines don't overload-clash
+    template <typename Engine, typename = void>
+    struct isEngine : std::false_type {};
+
+    template <typename Engine>
+    struct isEngine<Engine, std::void_t<typename Engine::result_type, decltype(std::declval<Engine&>()())>> : std::true_type {};
+
+    template <typename Function>
+    void parallelFor(const size_t, const unsigned, Function);    //Split [0, n) into contiguous ranges, one per thread
+
+    //Independent streams of the same seed
+    constexpr std::uint64_t STREAM_VALUES = 0;     //Element values
+    constexpr std::uint64_t STREAM_SWAPS = 1;     //NEARLY_SORTED swap positions
+    constexpr std::uint64_t STREAM_UNIQUE = 2;   //FEW_UNIQUE sample list (sub-stream 0) and picks (sub-stream 1)
+    constexpr std::uint64_t STREAM_COUNTS = 3;   //Sorted types: elements per bucket (one sub-stream per split)
+    constexpr std::uint64_t STREAM_BUCKETS = 4;  //Sorted types: values inside a bucket (one sub-stream per bucket)
+    constexpr std::uint64_t STREAM_SHAPED = 5;   //'Distribution' values (one sub-stream per 'SHAPED_CHUNK' elements)
+    constexpr std::uint64_t STREAM_BATCH = 6;    //'DatasetBatch' seeds (block k of the batch seed is dataset k's seed)
+    constexpr std::uint64_t STREAM_CHOICES = 7;  //DISTINCT: chosen values per bucket (one sub-stream per split)
+    constexpr std::uint64_t STREAM_SAMPLES = 8;  //DISTINCT: chosen values inside a bucket (one sub-stream per bucket)
+    constexpr std::uint64_t STREAM_SHUFFLE = 9;  //PERMUTATION, DISTINCT: bucket of every element (sub-stream 0) and each bucket's shuffle (sub-stream 1 + b)
+    constexpr std::uint64_t STREAM_RUNS = 10;    //ORGAN_PIPE, SAWTOOTH: seeds of the sorted runs (block r is run r's seed)
+    constexpr std::uint64_t STREAM_JOIN = 11;    //Joins: seeds of the key table and the build order (blocks 0, 1), probe hits (sub-stream 1), probe keys (sub-stream 2)
+    constexpr std::uint64_t STREAM_PAYLOAD = 12; //Record payloads (byte j of the payloads, record after record, is byte j of the stream)
+
+    constexpr std::uint64_t subStream(const std::uint64_t, const std::uint64_t) noexcept;    //Sub-stream 'index' of a stream (the low 8 bits say which stream)
+
+    constexpr size_t PARALLEL_GRAIN = 1 << 16;   //Smallest range worth giving its own thread
+
+    //Bulk kernels: 'out[2j + h] = base + scale(draw h of Philox block (first + j), range)' for j < blocks, with 1 <= range <= 2^32
+    using OffsetKernel = void (*)(std::uint32_t*, const std::uint64_t, const size_t, const std::uint64_t, const std::uint64_t, const std::uint64_t, const std::uint32_t);
+
+    void philoxOffsetsScalar(std::uint32_t*, const std::uint64_t, const size_t, const std::uint64_t, const std::uint64_t, const std::uint64_t, const std::uint32_t) noexcept;
+#if defined(DATASET_X86_SIMD)
+    void philoxOffsetsAVX2(std::uint32_t*, const std::uint64_t, const size_t, const std::uint64_t, const std::uint64_t, const std::uint64_t, const std::uint32_t) noexcept;
+    void philoxOffsetsAVX512(std::uint32_t*, const std::uint64_t, const size_t, const std::uint64_t, const std::uint64_t, const std::uint64_t, const std::uint32_t) noexcept;
+#elif defined(DATASET_NEON_SIMD)
+    void philoxOffsetsNEON(std::uint32_t*, const std::uint64_t, const size_t, const std::uint64_t, const std::uint64_t, const std::uint64_t, const std::uint32_t) noexcept;
+#endif
+
+    OffsetKernel offsetKernel() noexcept;     //The fastest kernel this CPU supports (checked once)
+
+    //Validators: the multiset checksum adds up 'mixValue()' of every element's bits (a bijection, so two different words never hash alike)
+    constexpr std::uint64_t mixValue(const std::uint64_t) noexcept;    //Philox2x32-style rounds: a 64-bit bijection built on 32x32 -> 64 bit multiplies
+
+    template <typename T>
+    std::uint64_t elementHash(const T) noexcept;                    //'mixValue()' of an element's bits (two words for 128-bit and extended-precision types)
+    template <typename T>
+    std::uint64_t hashSum(const T*, const size_t) noexcept;       //Sum of the elements' hashes (mod 2^64); 32- and 64-bit elements go through the bulk kernels
+
+    using HashSumKernel = std::uint64_t (*)(const void*, const size_t, const unsigned);    //Sum of 'mixValue()' of 'count' words of 'width' (4 or 8) bytes
+
+    std::uint64_t hashSumScalar(const void*, const size_t, const unsigned) noexcept;
+#if defined(DATASET_X86_SIMD)
+    std::uint64_t hashSumAVX2(const void*, const size_t, const unsigned) noexcept;
+#endif
+
+    HashSumKernel hashSumKernel() noexcept;    //The fastest kernel this CPU supports (checked once)
+
+    template <typename T>
+    bool sortedRange(const T*, const size_t) noexcept;    //Whether a range is in non-decreasing order (compared in branch-free blocks the compiler vectorizes)
+
+    template <typename Range>
+    using elementOf = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<const Range&>()))>>;    //What a range holds
+
+    template <typename Range>
+    std::pair<const elementOf<Range>*, size_t> contiguous(const Range&);    //(first element, length) of a contiguous range
+
+    constexpr size_t SORTED_BUCKET = 4096;              //Elements per bucket the sorted generator aims for (a bucket's scratch stays in L1/L2)
+    constexpr size_t SORTED_MAX_BUCKETS = 1 << 20;     //Most buckets (and most values counted one by one)
+    constexpr std::uint64_t SPACING_LIMIT = std::uint64_t(1) << 52;   //Widest bucket a double resolves to single values
+
+    constexpr size_t SHUFFLE_BUCKET = 1 << 16;         //Elements per bucket the parallel shuffle aims for (each bucket's Fisher-Yates pass stays in L2)
+    constexpr size_t SHUFFLE_MAX_BUCKETS = 1 << 12;   //Most buckets (the scatter writes to one open cache line per bucket)
+    constexpr size_t SHUFFLE_BLOCKS = 256;           //Fixed slices of the elements, counted separately (so the output can't depend on the thread count)
+    constexpr std::uint64_t SAMPLE_BITMAP = 64;     //Floyd's algorithm marks chosen values in a bitmap when the bucket is at most this many times wider than its sample
+
+    constexpr size_t VIEW_CHUNK = 1 << 14;    //Elements per chunk when streaming a 'DatasetView'
+    constexpr size_t PRODUCER_BLOCK = 256 * 1024;   //Bytes per 'DatasetProducer' block (half of a typical L2, so the consumer's working set fits next to it)
+
+    constexpr size_t KERNEL_CHUNK = 1024;    //Blocks per kernel call when converting to a narrower/wider 'T' (8KB staging buffer, stays in L1)
+    constexpr size_t KERNEL_MINIMUM = 32;    //Fewest elements worth a kernel call (small batch datasets still get the SIMD path)
+
+    //Distribution samplers
+    struct AliasEntry { std::uint32_t threshold, alias; };     //A column keeps its own index when the draw's low 32 bits are below 'threshold'
+    struct Ziggurat { double x[257], f[257]; };              //Layer edges (descending, x[256] = 0) and the density at each
+
+    std::vector<AliasEntry> aliasTable(const std::vector<double>&);             //Vose's alias method for the given weights
+    std::uint32_t aliasPick(const std::vector<AliasEntry>&, const std::uint64_t) noexcept;   //An index with probability proportional to its weight
+    Ziggurat buildZiggurat(const double, const double, double (*)(double), double (*)(double)) noexcept;   //tail start, layer area, density, inverse density
+    const Ziggurat& normalZiggurat() noexcept;          //Standard normal (built on first use)
+    const Ziggurat& exponentialZiggurat() noexcept;    //Exponential with rate 1 (built on first use)
+
+    template <bool symmetric, typename Engine, typename Density, typename Tail>
+    double ziggurat(const Ziggurat&, Engine&, Density, Tail);    //One sample; 'tail(u)' handles the base layer
+
+    template <typename Engine>
+    double standardNormal(Engine&);        //N(0, 1)
+
+    template <typename Engine>
+    double standardExponential(Engine&);  //Exp(1)
+
+    size_t hypergeometric(const std::uint64_t, const std::uint64_t, const size_t, double) noexcept;   //Of n draws without replacement from 'left + right' values, how many are 'left' ones (inverse CDF at u in [0, 1))
+    double logBinomial(const double, const double, const double, const double) noexcept;    //log P(x) for Binomial(n, p) (q = 1 - p), accurate even for n near 2^64 (Loader's saddle point form)
+    double stirlingError(const double) noexcept;        //log(n!) - log(sqrt(2 pi n) (n / e)^n)
+    double deviance(const double, const double) noexcept;   //x log(x / m) + m - x, without the cancellation when x is close to m
+
+    constexpr double NORMAL_TAIL = 3.6541528853610088;          //Marsaglia & Tsang's 256-layer constants (where the tail starts, area of each layer)
+    constexpr double NORMAL_AREA = 0.00492867323399;
+    constexpr double EXPONENTIAL_TAIL = 7.69711747013104972;
+    constexpr double EXPONENTIAL_AREA = 0.0039496598225815571993;
+    constexpr double PI = 3.14159265358979323846;
+
+    class StreamEngine;                       //64-bit draws of a seeded stream, generated in bulk (an engine for samplers that use a varying number of draws)
+
+    template <typename T, typename Engine>
+    T shapedValue(const Distribution&, const T, const T, Engine&);     //One sample, kept to [min, max] (rounded to the nearest integer for integer types)
+
+    template <DT dataT, typename T, typename Engine>
+    void genShapedData(T*, const size_t, const T, const T, const Distribution&, Engine&);       //Generate a new dataset with a distribution's values
+
+    template <DT dataT, typename T>
+    void genShapedDataParallel(T*, const size_t, const T, const T, const Distribution&, const Parallel);   //The same on several threads (output depends only on the seed)
+
+    template <typename T>
+    void fillShaped(T*, const std::uint64_t, const size_t, const T, const T, const Distribution&, const std::uint64_t);  //Elements [first, first + count) of a seed's distribution values
+
+    constexpr size_t SHAPED_CHUNK = 4096;    //Elements per sub-stream of distribution values (a thread regenerates at most one chunk it doesn't keep)
+    constexpr int SHAPED_TRIES = 64;        //Samples drawn for an element before out-of-range values are clamped to [min, max]
+
+    void* allocate(const size_t, const Memory);                 //Allocate aligned storage from the heap, from huge pages, or as untouched pages
+    size_t hugePageSize() noexcept;                             //The kernel's default huge page size (2 MiB where it can't be read)
+    size_t hugeLength(const size_t) noexcept;                  //A huge page mapping's length: bytes rounded up to whole huge pages
+    void deallocate(void*, const size_t, const Memory) noexcept;  //Release storage obtained from 'allocate()'
+    void place(void*, const size_t, const Numa&);                //Apply a NUMA placement to pages nobody has touched yet
+
+#if defined(DATASET_NUMA)
+    constexpr size_t NUMA_MAX_NODES = 1024;                      //Bits of the node masks passed to the kernel
+    bool allowedNodes(unsigned long (&)[NUMA_MAX_NODES / (8 * sizeof(unsigned long))]) noexcept;    //The allowed node mask (false without NUMA support)
+#endif
+
+    template <typename T>
+    class TextFormatter;                               //Values to text, in bulk ('std::to_chars' into a caller's buffer)
+
+    template <typename T, typename Fill>
+    void printStream(std::ostream&, const size_t, const TextFormat&, Fill);   //Format 'length' elements, produced in chunks by 'fill(buffer, first, count)'
+
+#if defined(DATASET_POSIX_IO)
+    class FileSink;                                    //Double-buffered writes to a file descriptor
+
+    template <typename T, typename Fill>
+    void writeStream(const int, const size_t, const Output&, Fill);    //Write 'length' elements, produced in chunks by 'fill(buffer, first, count)'
+
+    template <typename Writer>
+    void writeFile(const std::string&, const Output&, Writer);       //Create/truncate a file and pass its descriptor to 'writer(fd)'
+
+    void writeAll(const int, const char*, size_t);                  //'write()' until everything is written
+
+    constexpr size_t DIRECT_ALIGNMENT = 4096;    //Alignment 'O_DIRECT' asks of buffers, sizes and offsets
+
+    //Cache file header (the data follows right after it, so it stays 'DATASET_ALIGNMENT'-aligned in a page-aligned mapping)
+    struct CacheHeader
+    {
+        char magic[8];              //"DATASET" + '\0'
+        std::uint32_t version;     //'CACHE_VERSION' of the generator that wrote it
+        std::uint32_t type;       //sizeof(T) | signed << 8 | floating point << 9 | DT << 16
+        std::uint64_t size;      //Elements
+        std::uint64_t min;      //Range (bit patterns of the values)
+        std::uint64_t max;
+        std::uint64_t seed;   //Seed
+        std::uint64_t engine;      //Hash of the engine's name
+        std::uint64_t checksum;   //'checksum()' of the data
+    };
+
+    constexpr std::uint32_t CACHE_VERSION = 2;    //Bump whenever a generator's output for a given seed changes (older files then miss)
+
+    template <typename T, DT dataT>
+    CacheHeader cacheHeader(const size_t, const T, const T, const std::uint64_t, const char*);    //The header a dataset's cache file must have
+
+    template <typename T>
+    std::uint64_t rangeBits(const T) noexcept;     //A range bound as a header field (bit pattern; 128-bit values are folded)
+
+    std::string cachePath(const Cache&, const CacheHeader&);                     //File name for a header
+    void* mapCached(const std::string&, const CacheHeader&, const bool);       //Map a matching file's data copy-on-write (nullptr if missing or different)
+    void* createCached(const std::string&, const size_t);                     //Create a file for 'bytes' of data and map it shared, to generate into
+    void publishCached(void*, const size_t, CacheHeader, const std::string&, const std::string&);   //Checksum + header, unmap, rename into place
+
+    //Packed files ('Format::PACKED'): a header, then blocks of up to 'block' elements, each stored whichever of three ways is the smallest
+    enum class Encoding : std::uint8_t { RAW, DELTA, DICTIONARY };
+
+    struct PackedHeader
+    {
+        char magic[8];              //"DSPACKED"
+        std::uint32_t version;     //'PACKED_VERSION' of the writer
+        std::uint32_t type;       //sizeof(T) | signed << 8 | floating point << 9
+        std::uint64_t size;      //Elements
+        std::uint64_t block;    //Elements per block (the last one may hold fewer)
+    };
+
+    struct PackedBlock
+    {
+        Encoding encoding;          //RAW: the elements; DELTA: bit-packed differences; DICTIONARY: the different values, then bit-packed indices
+        std::uint8_t width;        //DELTA, DICTIONARY: bits per code
+        std::uint16_t reserved;
+        std::uint32_t count;     //Elements
+        std::uint64_t first;    //DELTA: the first element (bit pattern); DICTIONARY: entries of the dictionary
+        std::uint64_t step;    //DELTA: the smallest difference between neighbours (code i is difference i minus 'step')
+        std::uint64_t bytes;  //Bytes after this header (a multiple of 8, so every block header stays aligned)
+    };
+
+    constexpr std::uint32_t PACKED_VERSION = 1;    //Bump whenever the layout changes
+    constexpr size_t PACKED_BLOCK = 1 << 16;      //Elements per block (a block's codes, 256KB at most, stay in L2 while it is decoded)
+    constexpr size_t PACKED_LANES = 8;           //Interleaved 32-bit lanes of the bit-packed codes (one AVX2 vector)
+    constexpr size_t PACKED_ENTRIES = 1 << 14;  //Most entries a block's dictionary holds (past that, a block is stored another way)
+
+    template <typename T>
+    constexpr bool deltaPacked = std::is_integral<T>::value and not std::is_same<T, bool>::value;    //Types whose blocks can be stored as differences
+
+    struct PackScratch
+    {
+        std::vector<std::uint32_t> codes;       //The block's codes
+        std::vector<std::uint64_t> keys;       //Hash table of the dictionary: the value in each slot (bit pattern)...
+        std::vector<std::uint32_t> slots;     //...and its entry + 1 (0 is free)
+    };
+
+    size_t packedBytes(const size_t, const unsigned) noexcept;                                  //Bytes of 'count' codes of 'width' bits (whole rows of lanes, plus a row of padding)
+    void packCodes(const std::uint32_t*, const size_t, const unsigned, std::uint32_t*) noexcept;   //Code i goes to lane i % 8, at bit (i / 8) * width of that lane
+
+    using UnpackKernel = void (*)(const std::uint32_t*, const size_t, const unsigned, std::uint32_t*);    //'count' codes of 'width' bits (writes whole rows: round 'count' up to 8)
+
+    void unpackScalar(const std::uint32_t*, const size_t, const unsigned, std::uint32_t*) noexcept;
+#if defined(DATASET_X86_SIMD)
+    void unpackAVX2(const std::uint32_t*, const size_t, const unsigned, std::uint32_t*) noexcept;
+#endif
+
+    UnpackKernel unpackKernel() noexcept;    //The fastest kernel this CPU supports (checked once)
+
+    template <typename T>
+    constexpr size_t packedBound(const size_t) noexcept;             //Most bytes a block of 'count' elements takes (header included: stored raw)
+    template <typename T>
+    size_t packBlock(const T*, const size_t, char*, PackScratch&);  //Encode a block the smallest way; returns its bytes
+    template <typename T>
+    const char* unpackBlock(const char*, const char*, T*, std::vector<std::uint32_t>&);    //Decode a block (checked against the end of the file); returns the next
+#endif
+
+    std::uint64_t checksum(const void*, const size_t) noexcept;   //Fast 64-bit hash of a block of memory
+    std::uint64_t hashName(const char*) noexcept;                 //FNV-1a hash of a string
+
+    //Running totals of one phase (atomics, so generators on different threads can add to them)
+    struct PhaseTotals
+    {
+        std::atomic<std::uint64_t> calls{0}, nanoseconds{0}, elements{0}, bytes{0}, cacheMisses{0}, branchMisses{0}, counted{0};    //counted: calls with open counters
+    };
+
+    constexpr size_t PHASES = 7;             //Members of 'Phase'
+    inline PhaseTotals phaseTotals[PHASES];  //One set per program
+
+#if defined(DATASET_PROFILE)
+    class PhaseTimer;                       //Adds the time (and counters) of its lifetime to a phase's totals
+#if defined(DATASET_PERF_EVENTS)
+    class PerfCounters;                   //This thread's cache-miss and branch-miss counters (inherited by the threads it starts)
+    PerfCounters& perfCounters();        //Opened on a thread's first measured phase
+#endif
+#endif
+}
+
+//A sorted dataset, bucket by bucket: the value range is cut into equal slices and a tree of binomial draws decides how many elements land in
+//each one (their joint distribution is exactly that of sorting uniform draws). Narrow ranges get one bucket per value, so generating is just counting.
+template <typename T>
+class dataset_detail::SortedPlan
+{
+    // DATA MEMBERS //
+    private:
+        std::vector<size_t> offsets;    //offsets[b] = elements in the buckets below b
+        T min;                         //Smallest value of the range
+        std::uint64_t range;          //max - min
+        size_t elements;             //Dataset size
+        size_t count;               //Number of buckets
+        unsigned shift;            //2^shift equal buckets...
+        bool counting;            //...or one bucket per value
+
+    // FUNCTION MEMBERS //
+    private:
+        std::uint64_t start(const size_t) const noexcept;     //Bucket b's smallest value, as an offset from the minimum
+        template <typename Split>
+        void split(Split);                                   //Fill the bucket sizes from 'split(node, n, left width, right width)': how many of a node's n elements go left
+
+    public:
+        //Public special methods
+        SortedPlan() noexcept;                              //Empty plan (to 'reset()' later)
+        SortedPlan(const size_t, const T, const T);        //size, min, max
+
+        //Public methods
+        void reset(const size_t, const T, const T);      //Plan another size + range, reusing the bucket storage
+        template <typename Binomial>
+        void distribute(Binomial);                         //Split the elements between the buckets ('binomial(node, n, p)' draws from Binomial(n, p))
+        template <typename Hypergeometric>
+        void choose(Hypergeometric);                      //Split distinct elements between the buckets ('hypergeometric(node, n, left, right)'; see 'split()')
+        size_t buckets() const noexcept;                  //Number of buckets
+        size_t size() const noexcept;                    //Dataset size
+        size_t offset(const size_t) const noexcept;     //Ascending position of bucket b's first element
+        size_t find(const size_t) const noexcept;      //Bucket holding ascending position i
+        T lowest(const size_t) const noexcept;        //Bucket b's smallest value
+        std::uint64_t width(const size_t) const noexcept;    //Number of values in bucket b (0 = all 2^64)
+};
+
+//KeyMap maps the sorted generator's keys onto T, in order. Integers up to 64 bits are their own keys; floating point values are 2^52 evenly spaced
+//keys over [min, max) (the resolution of the mantissa trick); 128-bit integers are offsets from the minimum, so their range must be below 2^64
+template <typename T>
+class dataset_detail::KeyMap
+{
+    // DATA MEMBERS //
+    private:
+        T min;                      //Smallest value
+        T width;                   //max - min (floating point and 128-bit integers)
+
+    // FUNCTION MEMBERS //
+    public:
+        using Key = typename std::conditional<isReal<T> or isWide<T>::value, std::uint64_t, T>::type;
+        static constexpr bool direct = std::is_same<Key, T>::value;    //Keys are the values
+
+        //Public special methods
+        KeyMap(const T, const T) noexcept;           //min, max
+
+        //Public methods
+        bool enumerable() const noexcept;          //Every value has a key (false only for 128-bit ranges of 2^64 values or more)
+        Key lowest() const noexcept;              //Smallest key
+        Key highest() const noexcept;            //Largest key
+        T operator()(const Key) const noexcept; //The value of a key
+};
+
+//TextFormatter writes values, separators, line breaks and framing straight into a buffer: no streams, no locale, one 'std::to_chars' per value
+template <typename T>
+class dataset_detail::TextFormatter
+{
+    // DATA MEMBERS //
+    private:
+        std::string separator;      //Between values on a line
+        std::string lineBreak;     //Between lines
+        std::string closing;      //After the last value
+        bool json;               //Opens with '['
+        size_t lineWidth;       //Values per line (0 = no line breaks)
+        size_t remaining;      //Values still to format
+        size_t column;        //Values on the current line
+
+        //Most characters of one value: shortest round-trip form for floating point (sign, digits, point, exponent), every digit and a sign otherwise
+        static constexpr size_t DIGITS = isReal<T> ? std::numeric_limits<T>::max_digits10 + 8 : isWide<T>::value ? 41 : std::numeric_limits<T>::digits10 + 2;
+
+    // FUNCTION MEMBERS //
+    private:
+        //Private methods
+        static char* digits(char*, const T) noexcept;        //One value ('std::to_chars', which has no 128-bit overload in ISO C++)
+
+    public:
+        //Public special methods
+        TextFormatter(const TextFormat&, const size_t);     //layout, number of values
+
+        //Public methods
+        size_t widest() const noexcept;                          //Most bytes one value adds (with whatever follows it), and at least 'open()''s
+        char* open(char*) const noexcept;                       //Opening framing
+        char* format(char*, const T*, const size_t) noexcept;  //Values with their separators (the closing framing follows the last one)
+};
+
+#if defined(DATASET_POSIX_IO)
+//FileSink collects output in one buffer while the other one is written by a background task, so generating and writing overlap. With 'O_DIRECT'
+//only whole blocks are written; the remainder moves to the front of the next buffer
+class dataset_detail::FileSink
+{
+    // DATA MEMBERS //
+    private:
+        int fd;                          //Destination
+        bool direct;                    //The descriptor has 'O_DIRECT' set
+        size_t capacity;               //Bytes per buffer (a multiple of 'DIRECT_ALIGNMENT')
+        char* block;                  //Both buffers
+        char* current;               //Buffer being filled
+        size_t used;                //Bytes of 'current' filled
+        std::future<void> pending; //Write of the other buffer
+
+    // FUNCTION MEMBERS //
+    private:
+        void submit();                                      //Start writing 'current' in the background and switch buffers
+
+    public:
+        //Public special methods
+        FileSink(const int, const size_t);                //descriptor, bytes per buffer
+        FileSink(const FileSink&) = delete;
+        FileSink& operator=(const FileSink&) = delete;
+        ~FileSink();
+
+        //Public methods
+        size_t space() const noexcept;                 //Largest 'reserve()' that is always possible
+        char* reserve(const size_t);                  //Room for 'bytes' more bytes (writes out the buffer if it is too full)
+        void commit(const size_t) noexcept;          //Bytes of the reserved room actually used
+        void finish();                              //Write everything still buffered and wait for it
+};
+#endif
+
+//The tables behind a 'Distribution'
+struct Distribution::Table
+{
+    std::vector<dataset_detail::AliasEntry> alias;     //Zipf ranks or mixture components
+    std::vector<Distribution> components;             //Mixtures only
+};
+
+//StreamEngine hands out a seeded stream's 64-bit draws, generated 1024 at a time by the bulk kernel (draw j of stream s is words 2j and 2j + 1
+//of 'fillStream<uint32_t>(..., s)')
+class dataset_detail::StreamEngine
+{
+    // DATA MEMBERS //
+    private:
+        std::uint64_t seed, stream;                      //Which stream
+        std::uint64_t position;                         //Next word of the stream to generate
+        size_t next;                                   //Next unused word of 'words'
+        std::uint32_t words[2 * KERNEL_CHUNK];        //Current batch
+
+    // FUNCTION MEMBERS //
+    public:
+        using result_type = std::uint64_t;
+
+        //Public special methods
+        StreamEngine(const std::uint64_t, const std::uint64_t) noexcept;    //seed, stream
+
+        //Public methods
+        result_type operator()() noexcept;          //Next draw
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+};
+
+//The sorted generator's draws for bucket b of a seed: the bucket's sub-stream is generated in bulk (SIMD kernel) into a per-thread buffer, 32 bits
+//per element and two elements per draw, so a thread can only use one 'BucketDraws' at a time
+class dataset_detail::BucketDraws
+{
+    // DATA MEMBERS //
+    private:
+        const std::uint32_t* next;     //Next unused pair of words
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        BucketDraws(const std::uint64_t, const size_t, const size_t);   //seed, bucket, draws needed
+
+        //Public methods
+        std::uint64_t operator()() noexcept;    //Next 64-bit draw
+};
+
+
+/*
+    +----------------------------+
+    |        DatasetBase         |
+    +----------------------------+
+*/
+
+//DatasetBase contains everything common to 'Dataset' (inline array) and 'DynamicDataset' (runtime-sized storage)
+template <typename Derived, typename T, DT dataT, typename Engine>
+class DatasetBase
+{
+    //Guarding against non-numeric types
+    static_assert(dataset_detail::isElement<T>, "Dataset class can only be of an integral or floating-point type (int, unsigned int, double, __int128...etc)");
+    static_assert(not std::is_same<char, T>::value and not std::is_same<wchar_t, T>::value, "Dataset objects must be integral, not character");
+    static_assert(not dataset_detail::isReal<T> or (dataT != DT::PERMUTATION and dataT != DT::DISTINCT), "PERMUTATION and DISTINCT datasets must be integral");
+
+
+    // FUNCTION MEMBERS //
+    private:
+        constexpr T* data() noexcept;                 //The derived class' internal array
+        constexpr const T* data() const noexcept;    //The derived class' internal array (read-only)
+        constexpr size_t count() const noexcept;    //The derived class' length
+
+    public:
+        //Public methods
+        void genNewData(const T = 0, const T = 1000);    //Helper function: generates a new dataset of the appropriate type (RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED, FEW_UNIQUE)
+        void genNewData(const T, const T, const std::uint64_t);    //Generates a new dataset that only depends on the seed
+        void genNewData(const T, const T, const Parallel);        //Generates a new dataset on several threads; identical output for any thread count
+        constexpr void genNewData(const T, const T, const CompileTime);    //Generates a new dataset in a constant expression (see 'CompileTime')
+
+        template <typename Generator, typename = std::enable_if_t<dataset_detail::isEngine<Generator>::value>>
+        void genNewData(const T, const T, Generator&);             //Generates a new dataset from the caller's engine (its state advances)
+        void genNewData(const T, const T, const Distribution&);                          //Generates a new dataset with a distribution's values (kept to [min, max])
+        void genNewData(const T, const T, const Distribution&, const std::uint64_t);    //The same, only depending on the seed
+        void genNewData(const T, const T, const Distribution&, const Parallel);        //The same on several threads; identical output for any thread count
+        void genNewData(const T, const T, const Shard&, const Parallel);    //Generates one shard of a parallel dataset (the array holds the shard; see 'Shard')
+        void genNewData(const Collisions&, const std::uint64_t);    //Generates keys that collide in a hash table (DISTINCT 64-bit datasets; see 'Collisions')
+        void genNewData(const Collisions&, const Parallel);        //The same on several threads; identical output for any thread count
+        std::uint64_t genNewDataChecked(const T, const T, const Parallel);    //'genNewData()' that also returns the new data's 'multisetChecksum()', summed while each block is in cache
+        std::future<void> genNewDataAsync(const T, const T, const std::uint64_t);    //'genNewData()' on a background thread (leave the array alone until the future is ready)
+        std::future<void> genNewDataAsync(const T, const T, const Parallel);        //The same with parallel generation
+
+        template <typename Sort>
+        void genAdversary(const T, Sort);    //McIlroy's adversary for 'sort(first, last, less)': the values min, min + 1... in the order that does it the most harm
+        void perturb(const Disorder&);                            //Disturbs the current order (meant for sorted data; see 'Disorder')
+        void perturb(const Disorder&, const std::uint64_t);      //Disturbs the current order in a way that only depends on the seed
+        void print(std::ostream& = std::cout, const TextFormat& = TextFormat()) const;    //Prints the array (formatted in bulk, written in large blocks)
+#if defined(DATASET_POSIX_IO)
+        void write(const std::string&, const Output& = Output()) const;    //Writes the array to a file (binary by default)
+        void write(const int, const Output& = Output()) const;            //Writes the array to an open descriptor (file, pipe, socket)
+#endif
+        constexpr T* get() noexcept;                   //Return a pointer to the internal array
+        constexpr const T* get() const noexcept;      //Return a pointer to the internal array (read-only)
+
+        //Iterators
+        constexpr T* begin() noexcept;                    //Beginning of the array
+        constexpr T* end() noexcept;                     //End of the array
+        constexpr const T* begin() const noexcept;      //Beginning of the array (read-only)
+        constexpr const T* end() const noexcept;       //End of the array (read-only)
+
+        //Operator overloads
+        constexpr operator T*();                              //Implicit conversion to pointer (for passing to T[])
+        constexpr operator const T*() const;                 //Implicit conversion to pointer (for passing to const T[])
+        constexpr T& operator[](size_t);                    //[] Overload for accessing class like 'arr[5] = ...'
+        constexpr const T& operator[](size_t) const;       //[] Overload for reading a const dataset
+};
+
+
+/*
+    +----------------------------+
+    |          Dataset           |
+    +----------------------------+
+*/
+
+//Dataset class contains an inline array of random numeric values (the size is fixed at compile time)
+template <typename T, size_t size, DT dataT = DT::RANDOM, typename Engine = std::mt19937>  //Default distribution is 'RANDOM' (generic random dataset), default engine is the Mersenne Twister
+class Dataset : public DatasetBase<Dataset<T, size, dataT, Engine>, T, dataT, Engine>
+{
+    friend class DatasetBase<Dataset<T, size, dataT, Engine>, T, dataT, Engine>;    //The base class reaches the array through the derived class
+
+    // DATA MEMBERS //
+    private:
+        alignas(DATASET_ALIGNMENT) T dataset[size];     //Internal array
+
+    public:
+        static constexpr size_t length = size;   //const! (and not stored, so datasets can be assigned to each other)
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        constexpr Dataset(const T = 0, const T = 1000);   //default minimum, maximum
+        Dataset(const T, const T, const std::uint64_t);   //minimum, maximum, seed
+        Dataset(const T, const T, const Parallel);       //minimum, maximum, parallel settings
+        constexpr Dataset(const T, const T, const CompileTime);    //minimum, maximum, compile-time settings (a 'constexpr' dataset is computed by the compiler)
+};
+
+
+/*
+    +----------------------------+
+    |       DynamicDataset       |
+    +----------------------------+
+*/
+
+//DynamicDataset class contains a runtime-sized, 64-byte aligned array from the heap, huge pages, or a user-supplied arena
+template <typename T, DT dataT = DT::RANDOM, typename Engine = std::mt19937>  //Default distribution is 'RANDOM' (generic random dataset), default engine is the Mersenne Twister
+class DynamicDataset : public DatasetBase<DynamicDataset<T, dataT, Engine>, T, dataT, Engine>
+{
+    friend class DatasetBase<DynamicDataset<T, dataT, Engine>, T, dataT, Engine>;   //The base class reaches the array through the derived class
+
+    // DATA MEMBERS //
+    private:
+        T* dataset;              //Internal array (not owned when 'source' is 'Memory::ARENA')
+        Memory source;          //Where the internal array came from (decides how it is freed)
+        size_t elements;       //Number of elements (only a move or a swap changes it)
+
+    public:
+        const size_t& length;   //const! (bound to 'elements', so moved and swapped datasets stay consistent)
+
+    // FUNCTION MEMBERS //
+    private:
+        static T* acquire(const size_t, const T, const T, const Memory, Arena* = nullptr);    //Validate the arguments, then allocate the internal array
+        static T* acquire(const size_t, const T, const T, const Numa&);                     //Same with fresh pages, placed on the NUMA nodes
+
+        template <typename... Settings>
+        void populate(const Settings&...);    //Generate the first dataset (frees the array if generation throws)
+#if defined(DATASET_POSIX_IO)
+        template <typename Setting>
+        void load(const Cache&, const T, const T, const Setting, const char*);    //Map the cached dataset, generating (and caching) it first if needed
+#endif
+
+    public:
+        //Public special methods
+        explicit DynamicDataset(const size_t, const T = 0, const T = 1000, const Memory = Memory::HEAP);   //size, default minimum, maximum, memory source
+        DynamicDataset(const size_t, const T, const T, const std::uint64_t, const Memory = Memory::HEAP);    //size, minimum, maximum, seed, memory source
+        DynamicDataset(const size_t, const T, const T, const Parallel, const Memory = Memory::HEAP);     //size, minimum, maximum, parallel settings, memory source
+        DynamicDataset(const size_t, const T, const T, const Distribution&, const std::uint64_t, const Memory = Memory::HEAP);   //size, minimum, maximum, distribution, seed, memory source
+        DynamicDataset(const size_t, const T, const T, const Distribution&, const Parallel, const Memory = Memory::HEAP);       //size, minimum, maximum, distribution, parallel settings, memory source
+        DynamicDataset(const size_t, const T, const T, const Parallel, const Numa&);                                       //size, minimum, maximum, parallel settings, NUMA placement
+        DynamicDataset(const size_t, const T, const T, const Distribution&, const Parallel, const Numa&);                 //size, minimum, maximum, distribution, parallel settings, NUMA placement
+        DynamicDataset(const size_t, const Collisions&, const Parallel, const Memory = Memory::HEAP);                    //size, colliding keys, parallel settings, memory source
+        DynamicDataset(const Shard&, const T, const T, const Parallel, const Memory = Memory::HEAP);                    //shard, minimum, maximum, parallel settings, memory source
+        DynamicDataset(const size_t, Arena&, const T = 0, const T = 1000);                              //size, arena, default minimum, maximum
+        DynamicDataset(const size_t, Arena&, const T, const T, const std::uint64_t);                   //size, arena, minimum, maximum, seed
+        DynamicDataset(const size_t, Arena&, const T, const T, const Parallel);                        //size, arena, minimum, maximum, parallel settings
+#if defined(DATASET_POSIX_IO)
+        DynamicDataset(const size_t, const T, const T, const std::uint64_t, const Cache&);           //size, minimum, maximum, seed, cache
+        DynamicDataset(const size_t, const T, const T, const Parallel, const Cache&);               //size, minimum, maximum, parallel settings, cache
+#endif
+        DynamicDataset(const DynamicDataset&) = delete;                                                  //Copying a multi-GB array by accident is never intended
+        DynamicDataset& operator=(const DynamicDataset&) = delete;
+        DynamicDataset(DynamicDataset&&) noexcept;                                                      //Takes the array (the moved-from dataset is left empty)
+        DynamicDataset& operator=(DynamicDataset&&) noexcept;                                          //Frees this array, then takes the other one
+        ~DynamicDataset();
+
+        //Public methods
+        Memory memory() const noexcept;             //Where the internal array came from
+        void swap(DynamicDataset&) noexcept;       //Exchange arrays with another dataset (no copying, no allocation)
+};
+
+template <typename T, DT dataT, typename Engine>
+void swap(DynamicDataset<T, dataT, Engine>&, DynamicDataset<T, dataT, Engine>&) noexcept;     //Exchange two datasets' arrays
+
+
+/*
+    +----------------------------+
+    |        DatasetView         |
+    +----------------------------+
+*/
+
+//DatasetView is a dataset that is never stored: element i is computed on demand from (seed, i), so even a 100B-element view takes O(1) memory
+//(sorted types keep their bucket sizes, at most 8MB; few-unique ones their sample table). Its elements are exactly those of 'DynamicDataset<T, dataT>(size, min, max, Parallel{seed})'
+template <typename T, DT dataT = DT::RANDOM>    //Default distribution is 'RANDOM' (generic random dataset)
+class DatasetView
+{
+    //Guarding against non-numeric types
+    static_assert(dataset_detail::isElement<T>, "DatasetView class can only be of an integral or floating-point type (int, unsigned int, double, __int128...etc)");
+    static_assert(not std::is_same<char, T>::value and not std::is_same<wchar_t, T>::value, "DatasetView objects must be integral, not character");
+    static_assert(dataT != DT::PERMUTATION and dataT != DT::DISTINCT, "DatasetView can't compute PERMUTATION or DISTINCT elements one at a time (each depends on every other); use a DynamicDataset");
+    static_assert(not dataset_detail::isPattern(dataT), "DatasetView only computes the RANDOM, sorted and FEW_UNIQUE types; use a DynamicDataset for the worst-case patterns");
+
+    // DATA MEMBERS //
+    private:
+        struct Layout;                              //Sorted types: bucket sizes (and NEARLY_SORTED swaps), shared by every copy of the view
+        std::shared_ptr<const Layout> layout;      //Null for 'RANDOM' and 'FEW_UNIQUE'
+        std::shared_ptr<const std::vector<T>> samples;    //'FEW_UNIQUE': the sample table ({sqrt(size)} values)
+        std::uint64_t seed;                       //Seed
+        T min, max;                              //Range
+
+    public:
+        const size_t length;   //const!
+
+    // FUNCTION MEMBERS //
+    private:
+        T sorted(const size_t) const;            //Element i of the sorted (or reverse sorted) order, before any swaps
+
+    public:
+        class Iterator;                        //Random-access iterator that computes each element it is dereferenced at
+
+        //Public special methods
+        DatasetView(const size_t, const T, const T, const std::uint64_t);    //size, minimum, maximum, seed
+
+        //Public methods
+        void fill(T*, const size_t, const size_t) const;        //Compute elements [first, first + count) into a buffer
+        template <typename Function>
+        void forEachChunk(Function, const size_t = dataset_detail::VIEW_CHUNK) const;    //Call 'function(const T* chunk, size_t count)' on consecutive chunks
+        size_t size() const noexcept;                          //Number of elements
+        void print(std::ostream& = std::cout, const TextFormat& = TextFormat()) const;    //Prints the view
+#if defined(DATASET_POSIX_IO)
+        void write(const std::string&, const Output& = Output()) const;    //Generate straight to a file (binary by default)
+        void write(const int, const Output& = Output()) const;            //Generate straight to an open descriptor (file, pipe, socket)
+#endif
+
+        //Iterators
+        Iterator begin() const noexcept;                     //First element
+        Iterator end() const noexcept;                      //One past the last element
+
+        //Operator overloads
+        T operator[](const size_t) const;                 //Element i (random access costs one Philox block; a whole bucket for sorted types)
+};
+
+//Shared state of the sorted types
+template <typename T, DT dataT>
+struct DatasetView<T, dataT>::Layout
+{
+    dataset_detail::SortedPlan<typename dataset_detail::KeyMap<T>::Key> plan;    //Bucket sizes (of the keys, for floating point and 128-bit types)
+    std::vector<std::pair<size_t, size_t>> moved;   //NEARLY_SORTED: (position, sorted position it holds), by position
+    std::uint64_t id;                              //Tells the per-thread bucket caches of different views apart
+};
+
+//Iterates a 'DatasetView' by index; dereferencing computes the element (iterate with 'forEachChunk()' when every element is needed)
+template <typename T, DT dataT>
+class DatasetView<T, dataT>::Iterator
+{
+    // DATA MEMBERS //
+    private:
+        const DatasetView* view;     //Iterated view
+        size_t index;               //Current element
+
+    // FUNCTION MEMBERS //
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;       //Elements only exist once computed
+        using reference = T;
+
+        //Public special methods
+        Iterator(const DatasetView* = nullptr, const size_t = 0) noexcept;    //view, index
+
+        //Operator overloads
+        T operator*() const;
+        T operator[](const difference_type) const;
+        Iterator& operator++() noexcept;
+        Iterator operator++(int) noexcept;
+        Iterator& operator--() noexcept;
+        Iterator operator--(int) noexcept;
+        Iterator& operator+=(const difference_type) noexcept;
+        Iterator& operator-=(const difference_type) noexcept;
+        Iterator operator+(const difference_type) const noexcept;
+        Iterator operator-(const difference_type) const noexcept;
+        difference_type operator-(const Iterator&) const noexcept;
+        bool operator==(const Iterator&) const noexcept;
+        bool operator!=(const Iterator&) const noexcept;
+        bool operator<(const Iterator&) const noexcept;
+        bool operator>(const Iterator&) const noexcept;
+        bool operator<=(const Iterator&) const noexcept;
+        bool operator>=(const Iterator&) const noexcept;
+};
+
+
+/*
+    +----------------------------+
+    |      DatasetProducer       |
+    +----------------------------+
+*/
+
+//DatasetProducer emits a dataset block by block: 'nextBlock()' computes the next block (256KB by default) into the caller's buffer, so a streaming
+//consumer reads every block while it is still in cache. Its elements are exactly those of 'DynamicDataset<T, dataT>(size, min, max, Parallel{seed})',
+//for every DT: sorted types stay sorted across blocks, and the worst-case patterns are put together from sorted views. PERMUTATION and DISTINCT
+//elements each depend on every other, so those two are generated whole once and copied out a block at a time. Copies share the views (and the stored dataset)
+template <typename T, DT dataT = DT::RANDOM>
+class DatasetProducer
+{
+    //Views of dataT itself where one exists; the patterns are made of sorted runs
+    static constexpr bool whole = dataT == DT::PERMUTATION or dataT == DT::DISTINCT;
+    static constexpr DT viewType = whole or dataset_detail::isPattern(dataT) ? DT::SORTED : dataT;
+
+    // DATA MEMBERS //
+    private:
+        std::optional<DatasetView<T, viewType>> view;               //The dataset; ORGAN_PIPE: its rising half; SAWTOOTH: the current run; PUSH_*: the sorted order
+        std::optional<DatasetView<T, DT::REVERSE_SORTED>> falling;  //ORGAN_PIPE: the falling half
+        std::shared_ptr<DynamicDataset<T, dataT>> stored;          //PERMUTATION, DISTINCT: the whole dataset
+        std::uint64_t seed;                                       //Seed
+        T min, max;                                              //Range
+        T value;                                                //ALL_EQUAL: the value
+        size_t run;                                            //SAWTOOTH: the run 'view' computes
+        size_t block;                                         //Elements per block
+        size_t next;                                         //First element of the next block
+
+    public:
+        const size_t length;   //const!
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        DatasetProducer(const size_t, const T, const T, const std::uint64_t, const size_t = dataset_detail::PRODUCER_BLOCK);  //size, minimum, maximum, seed, bytes per block
+
+        //Public methods
+        size_t nextBlock(T*);                                 //Compute the next block into a buffer of 'blockSize()' elements (returns how many: 0 once done)
+        void fill(T*, const size_t, const size_t);           //Compute elements [first, first + count) into a buffer (any block, in any order)
+        size_t blockSize() const noexcept;                  //Elements per block
+        size_t position() const noexcept;                  //First element of the next block
+        void rewind() noexcept;                           //Start again from element 0
+};
+
+
+/*
+    +----------------------------+
+    |        DatasetBatch        |
+    +----------------------------+
+*/
+
+//One dataset of a 'DatasetBatch'
+template <typename T>
+struct BatchItem
+{
+    size_t size;                //Elements
+    DT type = DT::RANDOM;      //Distribution
+    T min = 0;                //Range
+    T max = 1000;
+};
+
+//DatasetSpan is a non-owning (pointer, length) view of one dataset of a batch
+template <typename T>
+class DatasetSpan
+{
+    // DATA MEMBERS //
+    private:
+        T* first;         //First element
+        size_t length;   //Elements
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        constexpr DatasetSpan(T*, const size_t) noexcept;    //first element, length
+
+        //Public methods
+        constexpr T* data() const noexcept;          //First element
+        constexpr size_t size() const noexcept;     //Number of elements
+        constexpr T* begin() const noexcept;       //Beginning of the dataset
+        constexpr T* end() const noexcept;        //End of the dataset
+
+        //Operator overloads
+        constexpr operator T*() const noexcept;              //Implicit conversion to pointer (for passing to T[])
+        constexpr T& operator[](const size_t) const noexcept;    //Element i
+};
+
+//DatasetBatch generates K datasets (of the same or mixed DT and ranges) into one contiguous, 64-byte aligned allocation. Small datasets are shared out
+//between the threads whole, large ones are split between all of them; dataset k holds exactly the elements of
+//'DynamicDataset<T, type>(size, min, max, Parallel{seed(k)})'
+template <typename T>
+class DatasetBatch
+{
+    //Guarding against non-numeric types
+    static_assert(dataset_detail::isElement<T>, "DatasetBatch class can only be of an integral or floating-point type (int, unsigned int, double, __int128...etc)");
+    static_assert(not std::is_same<char, T>::value and not std::is_same<wchar_t, T>::value, "DatasetBatch objects must be integral, not character");
+
+    // DATA MEMBERS //
+    private:
+        std::vector<BatchItem<T>> items;         //What each dataset is
+        std::vector<size_t> offsets;            //Dataset k starts at 'block + offsets[k]'; the last entry is the padded total
+        T* block;                              //Every dataset, back to back
+        Memory source;                        //Where 'block' came from
+        std::uint64_t base;                  //Batch seed
+        std::shared_ptr<const Distribution> shape;   //Shared by every dataset (null = uniform)
+
+    // FUNCTION MEMBERS //
+    private:
+        DatasetBatch(const std::vector<BatchItem<T>>&, std::shared_ptr<const Distribution>, const Parallel, const Memory);   //What both public constructors do
+
+        template <DT dataT>
+        void generate(const size_t, const unsigned);    //Generate dataset k with this many threads
+
+    public:
+        //Public special methods
+        DatasetBatch(const std::vector<BatchItem<T>>&, const Parallel, const Memory = Memory::HEAP);                        //datasets, parallel settings, memory source
+        DatasetBatch(const std::vector<BatchItem<T>>&, const Distribution&, const Parallel, const Memory = Memory::HEAP);  //datasets, distribution, parallel settings, memory source
+        DatasetBatch(const DatasetBatch&) = delete;                                                                        //One block for the whole batch; never copied by accident
+        DatasetBatch& operator=(const DatasetBatch&) = delete;
+        ~DatasetBatch();
+
+        //Public methods
+        void genNewData(const Parallel);                       //Regenerates every dataset in place from a new batch seed
+        size_t size() const noexcept;                         //Number of datasets
+        std::uint64_t seed(const size_t) const noexcept;     //Dataset k's own seed
+        T* data() noexcept;                                 //The whole block
+        const T* data() const noexcept;                    //The whole block (read-only)
+
+        //Operator overloads
+        DatasetSpan<T> operator[](const size_t) noexcept;               //Dataset k
+        DatasetSpan<const T> operator[](const size_t) const noexcept;  //Dataset k (read-only)
+};
+
+
+/*
+    +----------------------------+
+    |        JoinDataset         |
+    +----------------------------+
+*/
+
+//Join settings: a build side of 'keys' different keys, each on 'fanout' rows, and a probe side of 'probes' rows. A probe row's key is on the build
+//side with probability 'selectivity'; which key it is follows a Zipf law of exponent 'skew' over the keys (0 = every key equally likely)
+struct Join
+{
+    size_t keys;                 //Different keys of the build side
+    size_t probes;              //Probe rows
+    size_t fanout = 1;         //Build rows per key (the duplication factor)
+    double selectivity = 1;   //Share of the probe rows that find their key on the build side
+    double skew = 0;         //Zipf exponent of the keys' popularity on the probe side (the most popular key is chosen at random)
+};
+
+//JoinDataset generates the inputs of a join or group-by: the build and probe sides, each a key column and a payload column (SoA layout), in one 64-byte
+//aligned allocation. The keys are drawn once into a table of different values, like FEW_UNIQUE's sample table: the build rows repeat its first 'keys'
+//entries 'fanout' times each (in random order), and the probe misses pick from the rest, so they never meet a build key. Payloads are row numbers,
+//so a kernel's output can be checked row by row. Every column only depends on the seed, whatever the thread count
+template <typename K, typename P = K>
+class JoinDataset
+{
+    //Guarding against unsuitable types
+    static_assert(std::is_integral<K>::value and not std::is_same<bool, K>::value, "join keys must be integral (int, unsigned int, std::int64_t...etc)");
+    static_assert(not std::is_same<char, K>::value and not std::is_same<wchar_t, K>::value, "join keys must be integral, not character");
+    static_assert(std::is_arithmetic<P>::value and not std::is_same<bool, P>::value, "join payloads must be integral or floating-point");
+
+    // DATA MEMBERS //
+    private:
+        Join join;                          //Shape of the join
+        K min, max;                        //Range of the keys
+        std::vector<size_t> offsets;      //Byte offsets of the build keys, build payloads, probe keys and probe payloads in 'block'; the last entry is the total
+        char* block;                     //Every column, back to back
+        Memory source;                  //Where 'block' came from
+        size_t hits;                   //Probe rows whose key is on the build side
+
+    // FUNCTION MEMBERS //
+    private:
+        template <typename C>
+        C* column(const size_t) const noexcept;    //Column k
+
+    public:
+        //Public special methods
+        JoinDataset(const Join&, const K, const K, const Parallel, const Memory = Memory::HEAP);    //join, key minimum, key maximum, parallel settings, memory source
+        JoinDataset(const JoinDataset&) = delete;                                                   //One block for every column; never copied by accident
+        JoinDataset& operator=(const JoinDataset&) = delete;
+        ~JoinDataset();
+
+        //Public methods
+        void genNewData(const Parallel);                   //Regenerates every column in place from a new seed
+        size_t matches() const noexcept;                  //Rows of the equi-join (every probe hit meets 'fanout' build rows)
+        DatasetSpan<K> buildKeys() noexcept;             //Build side: keys
+        DatasetSpan<P> buildPayloads() noexcept;        //Build side: payloads (row numbers)
+        DatasetSpan<K> probeKeys() noexcept;           //Probe side: keys
+        DatasetSpan<P> probePayloads() noexcept;      //Probe side: payloads (row numbers)
+        DatasetSpan<const K> buildKeys() const noexcept;         //(read-only)
+        DatasetSpan<const P> buildPayloads() const noexcept;
+        DatasetSpan<const K> probeKeys() const noexcept;
+        DatasetSpan<const P> probePayloads() const noexcept;
+};
+
+
+/*
+    +----------------------------+
+    |       RecordDataset        |
+    +----------------------------+
+*/
+
+//How a 'RecordDataset' lays its records out: an array of records, or a key column next to a payload column
+enum class Layout { AOS, SOA };
+
+//What fills the payloads: the low byte of the record's row number in every byte (a memset per record), or random bytes (one bulk stream)
+enum class Payload { PATTERN, RANDOM };
+
+//Record: a key followed by a payload, 'bytes' in all (a power of two), aligned so no record of up to 64 bytes straddles a cache line. Records
+//compare by key, so the standard sorts take them as they are
+template <typename K, size_t bytes>
+struct alignas(bytes < DATASET_ALIGNMENT ? bytes : DATASET_ALIGNMENT) Record
+{
+    K key;                                       //Sort key
+    unsigned char payload[bytes - sizeof(K)];   //What the sort has to move along with it
+
+    constexpr bool operator<(const Record& other) const noexcept { return key < other.key; }
+    constexpr bool operator==(const Record& other) const noexcept { return key == other.key; }
+};
+
+//RecordDataset generates records of 'bytes' bytes (key plus payload), as AoS or SoA, into one 64-byte aligned allocation. The keys are exactly the
+//elements of 'DynamicDataset<K, dataT>(size, min, max, Parallel{seed})'; the payloads are filled in the same pass, a few hundred KB at a time
+template <typename K, size_t bytes, DT dataT = DT::RANDOM, Layout layout = Layout::AOS>
+class RecordDataset
+{
+    //Guarding against unsuitable records
+    static_assert(dataset_detail::isElement<K>, "record keys must be of an integral or floating-point type (int, unsigned int, double, __int128...etc)");
+    static_assert(not std::is_same<char, K>::value and not std::is_same<wchar_t, K>::value, "record keys must be integral, not character");
+    static_assert(bytes > sizeof(K) and (bytes & (bytes - 1)) == 0, "a record is a power of two bytes, with room for a payload after the key");
+    static_assert(sizeof(Record<K, bytes>) == bytes, "the key type's alignment leaves no room for a payload in a record this small");
+
+    public:
+        using record_type = Record<K, bytes>;
+        static constexpr size_t payloadBytes = bytes - sizeof(K);    //Payload of one record
+
+    // DATA MEMBERS //
+    private:
+        char* block;              //Every record (SOA: the keys, then the payloads)
+        Memory source;           //Where 'block' came from
+        size_t split;           //SOA: byte offset of the payloads in 'block'
+        size_t total;          //Bytes in 'block'
+        Payload payload;      //How the payloads are filled
+
+    public:
+        const size_t length;   //const!
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        RecordDataset(const size_t, const K, const K, const Parallel, const Payload = Payload::RANDOM, const Memory = Memory::HEAP);    //size, key minimum, key maximum, parallel settings, payload fill, memory source
+        RecordDataset(const RecordDataset&) = delete;                                                                                   //One block for every record; never copied by accident
+        RecordDataset& operator=(const RecordDataset&) = delete;
+        ~RecordDataset();
+
+        //Public methods
+        void genNewData(const K, const K, const Parallel);        //Regenerates every key and payload in place
+        size_t size() const noexcept;                            //Number of records
+        DatasetSpan<record_type> records() noexcept;            //AOS: the records
+        DatasetSpan<K> keys() noexcept;                        //SOA: the keys
+        DatasetSpan<unsigned char> payloads() noexcept;       //SOA: the payloads (record i's start at byte i * payloadBytes)
+        DatasetSpan<const record_type> records() const noexcept;    //(read-only)
+        DatasetSpan<const K> keys() const noexcept;
+        DatasetSpan<const unsigned char> payloads() const noexcept;
+};
+
+
+/*
+    +----------------------------+
+    |      DatasetPipeline       |
+    +----------------------------+
+*/
+
+//Pipeline settings: how many datasets are kept in the ring, and how many background threads refill them
+struct Prefetch
+{
+    size_t buffers = 2;         //Datasets in the ring: the one 'next()' gave out, the rest generated ahead
+    unsigned workers = 1;      //Background threads refilling returned datasets (each generation also uses 'Parallel::threads' threads)
+    size_t repeats = 1;       //Datasets in a row made from the same seed (dataset k uses seed + k / repeats), for repeated runs on one input
+    size_t total = 0;        //Datasets to make in all (0 = no limit), so nothing is generated for nothing at the end
+};
+
+//DatasetPipeline is a ring of datasets generated ahead of the consumer: 'next()' returns the next dataset of the sequence (waiting only if it isn't
+//ready yet) and hands the previous one back to the workers for refilling, so generation overlaps whatever runs on the data. Dataset k holds exactly
+//the elements of 'DynamicDataset<T, dataT>(size, min, max, Parallel{seed + k / repeats})'
+template <typename T, DT dataT = DT::RANDOM>
+class DatasetPipeline
+{
+    // DATA MEMBERS //
+    private:
+        std::vector<DynamicDataset<T, dataT>> ring;   //Dataset k lives in slot k % buffers
+        std::vector<size_t> sequence;                //Which dataset each slot holds (or is being refilled with)
+        std::vector<char> ready;                    //Slot filled (and not given out yet)
+        std::vector<std::exception_ptr> errors;    //What went wrong refilling a slot, rethrown by 'next()'
+        T min, max;                               //Range
+        Parallel parallel;                       //Seed of dataset 0, threads per generation
+        Prefetch settings;                      //Ring size, workers, repeats, total
+        size_t given;                          //Datasets 'next()' has given out
+        size_t returned;                      //Datasets handed back (every one before the last given out)
+        size_t claimed;                      //Next dataset a worker generates (dataset k waits for dataset k - buffers to be returned)
+        bool stopping;                      //The destructor is waiting for the workers
+        std::mutex lock;
+        std::condition_variable refill, filled;    //A slot was returned / a slot is ready
+        std::vector<std::thread> workers;
+
+    // FUNCTION MEMBERS //
+    private:
+        void work();    //Worker loop: refill returned slots, oldest first
+
+    public:
+        //Public special methods
+        DatasetPipeline(const size_t, const T, const T, const Parallel, const Prefetch& = Prefetch());   //size, minimum, maximum, parallel settings, ring settings
+        DatasetPipeline(const DatasetPipeline&) = delete;                                                //The workers hold on to the ring
+        DatasetPipeline& operator=(const DatasetPipeline&) = delete;
+        ~DatasetPipeline();                                                                            //Stops the workers (after the generations in progress)
+
+        //Public methods
+        DynamicDataset<T, dataT>& next();             //The next dataset (the previous one is refilled: don't touch it any more)
+        size_t position() const noexcept;            //Number of the dataset 'next()' gave out last
+        std::uint64_t seed(const size_t) const noexcept;    //Dataset k's seed
+};
+
+
+/*
+    +----------------------------+
+    |         Validators         |
+    +----------------------------+
+*/
+
+//Validators check a function's output on any contiguous range ('Dataset', 'DynamicDataset', 'DatasetSpan', 'std::vector'...), split between
+//threads (0 = all cores) and in vectorized blocks, so checking a sort costs a fraction of the sort
+template <typename Range>
+bool isSorted(const Range&, const unsigned = 0);    //Whether the elements are in non-decreasing order
+
+//Order-independent checksum of the elements' multiset: the sum of a 64-bit bijection of every element. A permutation of the data has the same checksum,
+//and a lost, duplicated or changed element all but surely changes it. 'genNewDataChecked()' computes the input's while generating it
+template <typename Range>
+std::uint64_t multisetChecksum(const Range&, const unsigned = 0);
+
+template <typename Range>
+std::vector<std::pair<dataset_detail::elementOf<Range>, size_t>> histogram(const Range&, const unsigned = 0);    //Every different value (in increasing order) and how often it appears
+
+
+#if defined(DATASET_POSIX_IO)
+
+/*
+    +----------------------------+
+    |        PackedReader        |
+    +----------------------------+
+*/
+
+//PackedReader decodes a file written with 'Format::PACKED' (the file is mapped read-only and streamed through). Each block of up to 64K elements
+//was stored the smallest of three ways: bit-packed differences from the previous element (integers: sorted, reverse sorted, sawtooth...), bit-packed
+//indices into a dictionary of its different values (few unique), or raw. Blocks are decoded one at a time ('nextBlock()') or all at once on
+//several threads ('read()'); the element type must be the writer's
+template <typename T>
+class PackedReader
+{
+    // DATA MEMBERS //
+    private:
+        std::string path;                       //For error messages
+        char* mapping;                         //The whole file
+        size_t bytes;                         //Bytes of the file
+        size_t elements, block;              //Elements in all, per block
+        const char* current;                //Header of the next block
+        size_t next;                       //Elements decoded so far by 'nextBlock()'
+        std::vector<std::uint32_t> codes;    //The current block's codes
+
+    public:
+        //Public special methods
+        explicit PackedReader(const std::string&);              //Maps the file and checks its header against 'T'
+        PackedReader(const PackedReader&) = delete;             //The mapping is owned
+        PackedReader& operator=(const PackedReader&) = delete;
+        ~PackedReader();
+
+        //Public methods
+        size_t nextBlock(T*);                     //Decode the next block into room for 'blockSize()' elements; returns its elements (0 at the end)
+        void read(T*, const unsigned = 0);       //Decode every block into room for 'size()' elements, on several threads (0 = all cores)
+        void rewind() noexcept;                 //Back to the first block
+        size_t size() const noexcept;          //Elements in the file
+        size_t blockSize() const noexcept;    //Most elements a block holds
+        size_t position() const noexcept;    //Elements 'nextBlock()' has decoded
+};
+
+#endif
+
+
+/*
+    +----------------------------+
+    |    Arena Implementation    |
+    +----------------------------+
+*/
+
+//Constructor
+inline Arena::Arena(void* buffer, const size_t bytes) noexcept: memory(static_cast<unsigned char*>(buffer)), capacity(bytes), offset(0)
+{
+}
+
+//Carve an aligned chunk out of the arena
+inline void* Arena::allocate(const size_t bytes, const size_t alignment)
+{
+    //Round the current position up to the requested alignment (alignment must be a power of two)
+    const size_t address = reinterpret_cast<size_t>(memory) + offset;
+    const size_t padding = (alignment - address % alignment) % alignment;
+
+    if (padding > capacity - offset or bytes > capacity - offset - padding)
+        throw std::bad_alloc();
+
+    offset += padding + bytes;
+    return memory + (offset - bytes);
+}
+
+//Reset the arena
+inline void Arena::reset() noexcept
+{
+    offset = 0;
+}
+
+//Bytes used
+inline size_t Arena::used() const noexcept
+{
+    return offset;
+}
+
+//Bytes available
+inline size_t Arena::available() const noexcept
+{
+    return capacity - offset;
+}
+
+/*
+    +----------------------------+
+    |   Engine Implementation    |
+    +----------------------------+
+*/
+
+//Constructor
+inline Philox4x32::Philox4x32(const std::uint64_t seed, const std::uint64_t stream) noexcept: key(seed), stream(stream), counter(0), buffer{}, used(4)
+{
+}
+
+//Next output
+inline Philox4x32::result_type Philox4x32::operator()() noexcept
+{
+    //Refill the buffer one block (4 outputs) at a time
+    if (used == 4)
+    {
+        buffer = block(key, counter++, stream);
+        used = 0;
+    }
+
+    return buffer[used++];
+}
+
+//Skip outputs
+inline void Philox4x32::discard(unsigned long long amount) noexcept
+{
+    //Use up what is left of the current block, then jump straight to the right block
+    for(; amount > 0 and used < 4; amount--)
+        used++;
+
+    counter += amount / 4;
+
+    if (amount % 4 != 0)
+    {
+        buffer = block(key, counter++, stream);
+        used = amount % 4;
+    }
+}
+
+//Philox4x32-10 block function
+inline std::array<std::uint32_t, 4> Philox4x32::block(const std::uint64_t key, const std::uint64_t counter, const std::uint64_t stream) noexcept
+{
+    std::uint32_t c0 = static_cast<std::uint32_t>(counter), c1 = static_cast<std::uint32_t>(counter >> 32);
+    std::uint32_t c2 = static_cast<std::uint32_t>(stream), c3 = static_cast<std::uint32_t>(stream >> 32);
+    std::uint32_t k0 = static_cast<std::uint32_t>(key), k1 = static_cast<std::uint32_t>(key >> 32);
+
+    //10 rounds of two 32x32 -> 64 bit multiplies, bumping the key (Weyl sequence) between rounds
+    for(int round=0; round < 10; round++)
+    {
+        const std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53u) * c0;
+        const std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57u) * c2;
+
+        c0 = static_cast<std::uint32_t>(product1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<std::uint32_t>(product1);
+        c2 = static_cast<std::uint32_t>(product0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<std::uint32_t>(product0);
+
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+
+    return {c0, c1, c2, c3};
+}
+
+// ********** SPLITMIX64 **********
+
+//Constructor
+constexpr SplitMix64::SplitMix64(const std::uint64_t seed) noexcept: state(seed)
+{
+}
+
+//Next output
+constexpr SplitMix64::result_type SplitMix64::operator()() noexcept
+{
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15u);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+}
+
+// ********** XOSHIRO256 **********
+
+//Constructor
+template <Scrambler scrambler>
+Xoshiro256<scrambler>::Xoshiro256(const std::uint64_t seed) noexcept
+{
+    //Recommended by the authors: SplitMix64 never produces the all-zero state
+    SplitMix64 expand(seed);
+    for(std::uint64_t& word : state)
+        word = expand();
+}
+
+//Next output
+template <Scrambler scrambler>
+typename Xoshiro256<scrambler>::result_type Xoshiro256<scrambler>::operator()() noexcept
+{
+    std::uint64_t result;
+
+    if constexpr (scrambler == Scrambler::PLUS)
+        result = state[0] + state[3];
+    else
+        result = dataset_detail::rotl(state[1] * 5, 7) * 9;
+
+    const std::uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = dataset_detail::rotl(state[3], 45);
+
+    return result;
+}
+
+//Apply a jump polynomial (the state after the jump is the XOR of the states where the polynomial has a 1 bit)
+template <Scrambler scrambler>
+void Xoshiro256<scrambler>::leap(const std::array<std::uint64_t, 4>& polynomial) noexcept
+{
+    std::array<std::uint64_t, 4> jumped{};
+
+    for(const std::uint64_t word : polynomial)
+    {
+        for(int bit=0; bit < 64; bit++)
+        {
+            if (word & std::uint64_t(1) << bit)
+            {
+                for(int i=0; i < 4; i++)
+                    jumped[i] ^= state[i];
+            }
+            (*this)();
+        }
+    }
+
+    state = jumped;
+}
+
+//Jump by 2^128
+template <Scrambler scrambler>
+void Xoshiro256<scrambler>::jump() noexcept
+{
+    leap({0x180EC6D33CFD0ABAu, 0xD5A61266F0C9392Cu, 0xA9582618E03FC9AAu, 0x39ABDC4529B1661Cu});
+}
+
+//Jump by 2^192
+template <Scrambler scrambler>
+void Xoshiro256<scrambler>::longJump() noexcept
+{
+    leap({0x76E15D3EFEFDCBBFu, 0xC5004E441C522FB3u, 0x77710069854EE241u, 0x39109BB02ACBE635u});
+}
+
+// ********** PCG64 **********
+
+//Constructor (same initialization as the reference 'pcg64_srandom_r()')
+inline Pcg64::Pcg64(const std::uint64_t seed, const std::uint64_t stream) noexcept: high(0), low(0), incrementHigh(stream >> 63), incrementLow(stream << 1 | 1)
+{
+    //Expand the 64-bit seed to a 128-bit initial state
+    SplitMix64 expand(seed);
+    const std::uint64_t initialHigh = expand(), initialLow = expand();
+
+    step();
+    low += initialLow;
+    high += initialHigh + (low < initialLow);    //carry
+    step();
+}
+
+//Advance the LCG
+inline void Pcg64::step() noexcept
+{
+    //Multiplier from the reference implementation: 0x2360ED051FC65DA44385DF649FCCF645
+    constexpr std::uint64_t multiplierHigh = 0x2360ED051FC65DA4u, multiplierLow = 0x4385DF649FCCF645u;
+
+    std::uint64_t carry;
+    const std::uint64_t productLow = dataset_detail::multiply64(low, multiplierLow, carry);
+    high = carry + high * multiplierLow + low * multiplierHigh;
+
+    low = productLow + incrementLow;
+    high += incrementHigh + (low < productLow);
+}
+
+//Next output (XOR the halves, then rotate by the top 6 bits)
+inline Pcg64::result_type Pcg64::operator()() noexcept
+{
+    step();
+    return dataset_detail::rotr(high ^ low, static_cast<int>(high >> 58));
+}
+
+// ********** WYRAND **********
+
+//Constructor
+inline WyRand::WyRand(const std::uint64_t seed) noexcept: state(seed)
+{
+}
+
+//Next output
+inline WyRand::result_type WyRand::operator()() noexcept
+{
+    state += 0xA0761D6478BD642Fu;
+
+    std::uint64_t high;
+    const std::uint64_t low = dataset_detail::multiply64(state, state ^ 0xE7037ED1A0B428DBu, high);
+    return high ^ low;
+}
+
+/*
+    +----------------------------+
+    | Distribution Implementation|
+    +----------------------------+
+*/
+
+// ********** DISTRIBUTION **********
+
+//Constructor
+inline Distribution::Distribution(const Shape shape, const double first, const double second, std::shared_ptr<const Table> table) noexcept:
+    shape(shape), first(first), second(second), table(std::move(table)) {}
+
+//Uniform values in [minimum, maximum)
+inline Distribution Distribution::uniform(const double min, const double max)
+{
+    if (not (min <= max) or not std::isfinite(max - min))
+        throw std::invalid_argument("invalid distribution; the minimum and maximum must be finite, and the maximum no less than the minimum.");
+
+    return Distribution(Shape::UNIFORM, min, max);
+}
+
+//Normal values
+inline Distribution Distribution::normal(const double mean, const double deviation)
+{
+    if (not std::isfinite(mean) or not (deviation >= 0) or not std::isfinite(deviation))
+        throw std::invalid_argument("invalid distribution; the mean must be finite and the standard deviation finite and non-negative.");
+
+    return Distribution(Shape::NORMAL, mean, deviation);
+}
+
+//Exponential values
+inline Distribution Distribution::exponential(const double rate)
+{
+    if (not (rate > 0) or not std::isfinite(rate))
+        throw std::invalid_argument("invalid distribution; the rate must be positive.");
+
+    return Distribution(Shape::EXPONENTIAL, rate, 0);
+}
+
+//Zipf ranks
+inline Distribution Distribution::zipf(const size_t ranks, const double exponent)
+{
+    if (ranks == 0 or ranks > (std::uint64_t(1) << 32))
+        throw std::invalid_argument("invalid distribution; Zipf needs between 1 and 2^32 ranks.");
+
+    if (not (exponent >= 0) or not std::isfinite(exponent))
+        throw std::invalid_argument("invalid distribution; the exponent must be finite and non-negative.");
+
+    std::vector<double> weights(ranks);
+    for(size_t k=0; k < ranks; k++)
+        weights[k] = std::pow(static_cast<double>(k + 1), -exponent);
+
+    auto shared = std::make_shared<Table>();
+    shared->alias = dataset_detail::aliasTable(weights);
+    return Distribution(Shape::ZIPF, static_cast<double>(ranks), exponent, std::move(shared));
+}
+
+//Pareto values
+inline Distribution Distribution::powerLaw(const double exponent, const double smallest)
+{
+    if (not (exponent > 1) or not std::isfinite(exponent) or not (smallest > 0) or not std::isfinite(smallest))
+        throw std::invalid_argument("invalid distribution; a power law needs an exponent above 1 and a positive smallest value.");
+
+    return Distribution(Shape::POWER_LAW, exponent, smallest);
+}
+
+//Weighted mixture of other distributions
+inline Distribution Distribution::mixture(const std::vector<std::pair<double, Distribution>>& parts)
+{
+    if (parts.empty())
+        throw std::invalid_argument("invalid distribution; a mixture needs at least one component.");
+
+    std::vector<double> weights;
+    auto shared = std::make_shared<Table>();
+
+    for(const std::pair<double, Distribution>& part : parts)
+    {
+        weights.push_back(part.first);
+        shared->components.push_back(part.second);
+    }
+
+    shared->alias = dataset_detail::aliasTable(weights);
+    return Distribution(Shape::MIXTURE, 0, 0, std::move(shared));
+}
+
+//One sample
+template <typename Engine>
+double Distribution::operator()(Engine& RNG) const
+{
+    if (shape == Shape::UNIFORM)
+        return first + dataset_detail::unitDouble(dataset_detail::draw64(RNG)) * (second - first);
+    else if (shape == Shape::NORMAL)
+        return first + second * dataset_detail::standardNormal(RNG);
+    else if (shape == Shape::EXPONENTIAL)
+        return dataset_detail::standardExponential(RNG) / first;
+    else if (shape == Shape::ZIPF)
+        return 1.0 + dataset_detail::aliasPick(table->alias, dataset_detail::draw64(RNG));
+    else if (shape == Shape::POWER_LAW)
+        return second * std::exp(dataset_detail::standardExponential(RNG) / (first - 1));    //x = smallest * e^(E / (exponent - 1)) is Pareto for E ~ Exp(1)
+    else
+        return table->components[dataset_detail::aliasPick(table->alias, dataset_detail::draw64(RNG))](RNG);
+}
+
+//Which shape
+inline Shape Distribution::kind() const noexcept
+{
+    return shape;
+}
+
+// ********** COLLISIONS **********
+
+//Inverse of an odd number modulo 2^64: Newton's iteration doubles the correct low bits each step, and a * a = 1 (mod 8) gives the first 3
+constexpr std::uint64_t dataset_detail::inverseOdd(const std::uint64_t a) noexcept
+{
+    std::uint64_t inverse = a;
+    for(int step=0; step < 5; step++)
+        inverse *= 2 - a * inverse;
+
+    return inverse;
+}
+
+//Constructor
+inline Collisions::Collisions(Hash hash, Hash inverse, const std::uint64_t buckets, const std::uint64_t bucket): hash(std::move(hash)), inverse(std::move(inverse)), buckets(buckets), bucket(bucket)
+{
+    if (not this->hash or not this->inverse)
+        throw std::invalid_argument("invalid collisions; both the hash and its inverse are needed.");
+
+    if (buckets == 0 or bucket >= buckets)
+        throw std::invalid_argument("invalid collisions; the table needs at least one bucket, and the bucket must be one of them.");
+
+    //A wrong inverse would quietly give keys that don't collide: check it on the first, middle and last colliding hash values
+    for(const std::uint64_t k : {std::uint64_t(0), std::uint64_t(1), last() / 2, last()})
+    {
+        if (this->hash(key(k)) != bucket + k * buckets)
+            throw std::invalid_argument("invalid collisions; the inverse doesn't undo the hash.");
+    }
+}
+
+//The key itself
+inline Collisions Collisions::identity(const std::uint64_t buckets, const std::uint64_t bucket)
+{
+    const auto same = [](const std::uint64_t key) { return key; };
+    return Collisions(same, same, buckets, bucket);
+}
+
+//key * multiplier (mod 2^64)
+inline Collisions Collisions::multiplicative(const std::uint64_t multiplier, const std::uint64_t buckets, const std::uint64_t bucket)
+{
+    if (multiplier % 2 == 0)
+        throw std::invalid_argument("invalid collisions; the multiplier must be odd (an even one loses bits, so it can't be undone).");
+
+    const std::uint64_t inverse = dataset_detail::inverseOdd(multiplier);
+    return Collisions([=](const std::uint64_t key) { return key * multiplier; }, [=](const std::uint64_t hash) { return hash * inverse; }, buckets, bucket);
+}
+
+//MurmurHash3's 64-bit finalizer: every step is invertible (a shift of 33 or more undoes itself, and the multipliers are odd)
+inline Collisions Collisions::murmur(const std::uint64_t buckets, const std::uint64_t bucket)
+{
+    constexpr std::uint64_t FIRST = 0xFF51AFD7ED558CCDu, SECOND = 0xC4CEB9FE1A85EC53u;
+    constexpr std::uint64_t UNDO_FIRST = dataset_detail::inverseOdd(FIRST), UNDO_SECOND = dataset_detail::inverseOdd(SECOND);
+
+    const auto fmix64 = [](std::uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= FIRST;
+        key ^= key >> 33;
+        key *= SECOND;
+        return key ^ key >> 33;
+    };
+    const auto undo = [](std::uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= UNDO_SECOND;
+        hash ^= hash >> 33;
+        hash *= UNDO_FIRST;
+        return hash ^ hash >> 33;
+    };
+    return Collisions(fmix64, undo, buckets, bucket);
+}
+
+//The key whose hash is the k-th colliding value
+inline std::uint64_t Collisions::key(const std::uint64_t k) const
+{
+    return inverse(bucket + k * buckets);
+}
+
+//The largest k whose hash value still fits 64 bits
+inline std::uint64_t Collisions::last() const noexcept
+{
+    return (std::numeric_limits<std::uint64_t>::max() - bucket) / buckets;
+}
+
+// ********** SAMPLERS **********
+
+//Vose's alias method: column i keeps i with probability 'threshold / 2^32', otherwise gives 'alias'
+inline std::vector<dataset_detail::AliasEntry> dataset_detail::aliasTable(const std::vector<double>& weights)
+{
+    if (weights.empty() or weights.size() > (std::uint64_t(1) << 32))
+        throw std::invalid_argument("invalid distribution; an alias table needs between 1 and 2^32 weights.");
+
+    double total = 0;
+    for(const double weight : weights)
+    {
+        if (not (weight >= 0) or not std::isfinite(weight))
+            throw std::invalid_argument("invalid distribution; weights must be finite and non-negative.");
+        total += weight;
+    }
+
+    if (not (total > 0) or not std::isfinite(total))
+        throw std::invalid_argument("invalid distribution; the weights must have a positive, finite sum.");
+
+    //Scale so the average column holds exactly 1, then pair every underfull column with an overfull one
+    const size_t n = weights.size();
+    std::vector<double> scaled(n);
+    std::vector<std::uint32_t> small, large;
+    for(size_t i=0; i < n; i++)
+    {
+        scaled[i] = weights[i] * static_cast<double>(n) / total;
+        (scaled[i] < 1 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    std::vector<AliasEntry> table(n);
+    while (not small.empty() and not large.empty())
+    {
+        const std::uint32_t under = small.back(), over = large.back();
+        small.pop_back();
+
+        table[under] = {static_cast<std::uint32_t>(scaled[under] * 4294967296.0), over};
+        scaled[over] -= 1 - scaled[under];
+
+        if (scaled[over] < 1)
+        {
+            large.pop_back();
+            small.push_back(over);
+        }
+    }
+
+    //Whatever is left is full (up to rounding): it always keeps its own index
+    for(const std::vector<std::uint32_t>* rest : {&small, &large})
+        for(const std::uint32_t i : *rest)
+            table[i] = {std::numeric_limits<std::uint32_t>::max(), i};
+
+    return table;
+}
+
+//Pick an index: the high 32 bits choose the column, the low 32 bits decide between it and its alias
+inline std::uint32_t dataset_detail::aliasPick(const std::vector<AliasEntry>& table, const std::uint64_t bits) noexcept
+{
+    const std::uint32_t column = static_cast<std::uint32_t>(((bits >> 32) * table.size()) >> 32);
+    const AliasEntry& entry = table[column];
+    return static_cast<std::uint32_t>(bits) < entry.threshold ? column : entry.alias;
+}
+
+//Layer edges from the tail start and the common layer area (x[0] is the base layer's width, counting its tail)
+inline dataset_detail::Ziggurat dataset_detail::buildZiggurat(const double tail, const double area, double (*density)(double), double (*inverse)(double)) noexcept
+{
+    Ziggurat table;
+    table.x[0] = area / density(tail);
+    table.x[1] = tail;
+
+    for(size_t i=1; i < 256; i++)
+        table.x[i + 1] = inverse(std::min(1.0, area / table.x[i] + density(table.x[i])));
+    table.x[256] = 0;
+
+    for(size_t i=0; i <= 256; i++)
+        table.f[i] = density(table.x[i]);
+    return table;
+}
+
+//Standard normal ziggurat
+inline const dataset_detail::Ziggurat& dataset_detail::normalZiggurat() noexcept
+{
+    static const Ziggurat table = buildZiggurat(NORMAL_TAIL, NORMAL_AREA, [](const double x) { return std::exp(-x * x / 2); },
+                                                [](const double y) { return std::sqrt(-2 * std::log(y)); });
+    return table;
+}
+
+//Exponential ziggurat
+inline const dataset_detail::Ziggurat& dataset_detail::exponentialZiggurat() noexcept
+{
+    static const Ziggurat table = buildZiggurat(EXPONENTIAL_TAIL, EXPONENTIAL_AREA, [](const double x) { return std::exp(-x); },
+                                                [](const double y) { return -std::log(y); });
+    return table;
+}
+
+//One ziggurat sample: pick a layer with the low 8 bits, a position in it with the top 52; nearly every draw lands inside the layer's rectangle
+template <bool symmetric, typename Engine, typename Density, typename Tail>
+double dataset_detail::ziggurat(const Ziggurat& table, Engine& RNG, Density density, Tail tail)
+{
+    while (true)
+    {
+        const std::uint64_t bits = draw64(RNG);
+        const size_t layer = bits & 0xFF;
+        const double u = symmetric ? 2 * unitDouble(bits) - 1 : unitDouble(bits);
+        const double x = u * table.x[layer];
+
+        if (std::abs(x) < table.x[layer + 1])
+            return x;
+
+        if (layer == 0)
+            return tail(u);
+
+        if (table.f[layer + 1] + (table.f[layer] - table.f[layer + 1]) * unitDouble(draw64(RNG)) < density(x))
+            return x;
+    }
+}
+
+//N(0, 1)
+template <typename Engine>
+double dataset_detail::standardNormal(Engine& RNG)
+{
+    return ziggurat<true>(normalZiggurat(), RNG, [](const double x) { return std::exp(-x * x / 2); }, [&](const double u)
+    {
+        //Marsaglia's tail method: x > tail with density ~ e^(-x^2 / 2)
+        double x, y;
+        do
+        {
+            x = std::log(1 - unitDouble(draw64(RNG))) / NORMAL_TAIL;
+            y = std::log(1 - unitDouble(draw64(RNG)));
+        }
+        while (-2 * y < x * x);
+
+        return u < 0 ? x - NORMAL_TAIL : NORMAL_TAIL - x;
+    });
+}
+
+//Exp(1)
+template <typename Engine>
+double dataset_detail::standardExponential(Engine& RNG)
+{
+    return ziggurat<false>(exponentialZiggurat(), RNG, [](const double x) { return std::exp(-x); }, [&](const double)
+    {
+        //Memoryless: the tail is the tail start plus another Exp(1)
+        return EXPONENTIAL_TAIL - std::log(1 - unitDouble(draw64(RNG)));
+    });
+}
+
+//Hypergeometric inverse CDF: P(mode) accurately, then outwards from the mode through the ratios between neighbours, so 'u' runs out after
+//O(standard deviation) steps
+inline size_t dataset_detail::hypergeometric(const std::uint64_t left, const std::uint64_t right, const size_t draws, double u) noexcept
+{
+    //x draws among the 'left' values leave 'draws - x' among the 'right' ones
+    const size_t lowest = draws > right ? draws - static_cast<size_t>(right) : 0;
+    const size_t highest = static_cast<size_t>(std::min<std::uint64_t>(draws, left));
+    if (lowest == highest)
+        return lowest;
+
+    const double n = static_cast<double>(draws), K = static_cast<double>(left), R = static_cast<double>(right), N = K + R;
+    const size_t mode = std::min(highest, std::max(lowest, static_cast<size_t>((n + 1) * (K + 1) / (N + 2))));
+
+    //P(x) = (K choose x) (R choose n - x) / (N choose n), from three binomial probabilities at p = n / N (their p^x q^(n - x) factors cancel)
+    const double p = n / N, q = (N - n) / N, x = static_cast<double>(mode);
+    const double peak = std::exp(logBinomial(x, K, p, q) + logBinomial(n - x, R, p, q) - logBinomial(n, N, p, q));
+
+    u -= peak;
+    if (u < 0)
+        return mode;
+
+    //P(x + 1) / P(x) = (K - x)(n - x) / ((x + 1)(R - n + x + 1)); both tails shrink faster than geometrically, so once they are negligible, the
+    //rest of 'u' is rounding error
+    double up = peak, down = peak;
+    size_t above = mode, below = mode;
+
+    while ((above < highest and up > 1e-30) or (below > lowest and down > 1e-30))
+    {
+        if (above < highest)
+        {
+            const double at = static_cast<double>(above++);
+            up *= (K - at) * (n - at) / ((at + 1) * (R - n + at + 1));
+            if ((u -= up) < 0)
+                return above;
+        }
+
+        if (below > lowest)
+        {
+            const double at = static_cast<double>(below--);
+            down *= at * (R - n + at) / ((K - at + 1) * (n - at + 1));
+            if ((u -= down) < 0)
+                return below;
+        }
+    }
+
+    return mode;
+}
+
+//log of the binomial probability of x (Loader, "Fast and accurate computation of binomial probabilities"): every term stays small, so nothing
+//cancels even when n is 2^64
+inline double dataset_detail::logBinomial(const double x, const double n, const double p, const double q) noexcept
+{
+    if (x == 0)
+        return n == 0 ? 0 : n * (p < q ? std::log1p(-p) : std::log(q));
+    if (x == n)
+        return n * (q < p ? std::log1p(-q) : std::log(p));
+
+    const double exponent = stirlingError(n) - stirlingError(x) - stirlingError(n - x) - deviance(x, n * p) - deviance(n - x, n * q);
+    return exponent - 0.5 * (std::log(2 * PI * x) + std::log1p(-x / n));
+}
+
+//Stirling's series error term
+inline double dataset_detail::stirlingError(const double n) noexcept
+{
+    constexpr double S0 = 1.0 / 12, S1 = 1.0 / 360, S2 = 1.0 / 1260, S3 = 1.0 / 1680, S4 = 1.0 / 1188;
+    const double nn = n * n;
+
+    //Small n: the series hasn't converged yet, but 'lgamma()' is exact enough there
+    if (n < 16)
+        return std::lgamma(n + 1) - (n + 0.5) * std::log(n) + n - 0.5 * std::log(2 * PI);
+    if (n > 500)
+        return (S0 - S1 / nn) / n;
+    if (n > 80)
+        return (S0 - (S1 - S2 / nn) / nn) / n;
+    if (n > 35)
+        return (S0 - (S1 - (S2 - S3 / nn) / nn) / nn) / n;
+    return (S0 - (S1 - (S2 - (S3 - S4 / nn) / nn) / nn) / nn) / n;
+}
+
+//Deviance term of the saddle point expansion
+inline double dataset_detail::deviance(const double x, const double m) noexcept
+{
+    //Close to m: the series in v = (x - m) / (x + m), which converges quickly for |v| < 0.1
+    if (std::fabs(x - m) < 0.1 * (x + m))
+    {
+        double v = (x - m) / (x + m), sum = (x - m) * v, term = 2 * x * v;
+        v *= v;
+
+        for(int j=1; ; j++)
+        {
+            term *= v;
+            const double next = sum + term / (2 * j + 1);
+            if (next == sum)
+                return sum;
+            sum = next;
+        }
+    }
+
+    return x * std::log(x / m) + m - x;
+}
+
+//Stream engine
+inline dataset_detail::StreamEngine::StreamEngine(const std::uint64_t seed, const std::uint64_t stream) noexcept: seed(seed), stream(stream), position(0), next(2 * KERNEL_CHUNK) {}
+
+//Next draw
+inline std::uint64_t dataset_detail::StreamEngine::operator()() noexcept
+{
+    if (next == 2 * KERNEL_CHUNK)
+    {
+        fillStream<std::uint32_t>(words, position, 2 * KERNEL_CHUNK, 0, std::numeric_limits<std::uint32_t>::max(), seed, stream);
+        position += 2 * KERNEL_CHUNK;
+        next = 0;
+    }
+
+    next += 2;
+    return static_cast<std::uint64_t>(words[next - 1]) << 32 | words[next - 2];
+}
+
+
+/*
+    +----------------------------+
+    |         Profiling          |
+    +----------------------------+
+*/
+
+//Throughput of a phase
+inline double PhaseProfile::elementsPerSecond() const noexcept
+{
+    return seconds > 0 ? static_cast<double>(elements) / seconds : 0;
+}
+
+//A phase's totals
+inline PhaseProfile profile(const Phase phase)
+{
+    const dataset_detail::PhaseTotals& totals = dataset_detail::phaseTotals[static_cast<size_t>(phase)];
+
+    PhaseProfile result;
+    result.calls = totals.calls.load(std::memory_order_relaxed);
+    result.seconds = static_cast<double>(totals.nanoseconds.load(std::memory_order_relaxed)) * 1e-9;
+    result.elements = totals.elements.load(std::memory_order_relaxed);
+    result.bytes = totals.bytes.load(std::memory_order_relaxed);
+    result.cacheMisses = totals.cacheMisses.load(std::memory_order_relaxed);
+    result.branchMisses = totals.branchMisses.load(std::memory_order_relaxed);
+    result.counted = result.calls > 0 and totals.counted.load(std::memory_order_relaxed) == result.calls;
+    return result;
+}
+
+//Start over
+inline void resetProfile() noexcept
+{
+    for(dataset_detail::PhaseTotals& totals : dataset_detail::phaseTotals)
+    {
+        totals.calls = 0;
+        totals.nanoseconds = 0;
+        totals.elements = 0;
+        totals.bytes = 0;
+        totals.cacheMisses = 0;
+        totals.branchMisses = 0;
+        totals.counted = 0;
+    }
+}
+
+#if defined(DATASET_PROFILE)
+#if defined(DATASET_PERF_EVENTS)
+//PerfCounters keeps two hardware counters open for a thread's lifetime. They are inherited, so the threads a generator starts count too (their
+//counts are added when they exit, which is before the generator returns)
+class dataset_detail::PerfCounters
+{
+    // DATA MEMBERS //
+    private:
+        int cache, branch;     //Counter descriptors (-1 if the kernel refused)
+
+    // FUNCTION MEMBERS //
+    private:
+        static int open(const std::uint64_t) noexcept;     //One user-space hardware counter of this thread
+        static std::uint64_t read(const int) noexcept;    //Its count so far (0 if it isn't open)
+
+    public:
+        //Public special methods
+        PerfCounters() noexcept;
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+        ~PerfCounters();
+
+        //Public methods
+        bool active() const noexcept;                   //Whether the kernel allowed both counters
+        std::uint64_t cacheMisses() const noexcept;     //Last-level cache misses so far
+        std::uint64_t branchMisses() const noexcept;   //Mispredicted branches so far
+};
+
+//Open both counters
+inline dataset_detail::PerfCounters::PerfCounters() noexcept: cache(open(PERF_COUNT_HW_CACHE_MISSES)), branch(open(PERF_COUNT_HW_BRANCH_MISSES)) {}
+
+//Close them
+inline dataset_detail::PerfCounters::~PerfCounters()
+{
+    for(const int fd : {cache, branch})
+        if (fd >= 0)
+            close(fd);
+}
+
+//One counter
+inline int dataset_detail::PerfCounters::open(const std::uint64_t event) noexcept
+{
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = event;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;     //Allowed at the default 'perf_event_paranoid' level
+    attributes.exclude_hv = 1;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+//A count
+inline std::uint64_t dataset_detail::PerfCounters::read(const int fd) noexcept
+{
+    std::uint64_t count = 0;
+    if (fd < 0 or ::read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+        return 0;
+
+    return count;
+}
+
+//Both counters open
+inline bool dataset_detail::PerfCounters::active() const noexcept
+{
+    return cache >= 0 and branch >= 0;
+}
+
+//Cache misses so far
+inline std::uint64_t dataset_detail::PerfCounters::cacheMisses() const noexcept
+{
+    return read(cache);
+}
+
+//Branch misses so far
+inline std::uint64_t dataset_detail::PerfCounters::branchMisses() const noexcept
+{
+    return read(branch);
+}
+
+//This thread's counters
+inline dataset_detail::PerfCounters& dataset_detail::perfCounters()
+{
+    thread_local PerfCounters counters;
+    return counters;
+}
+#endif
+
+//PhaseTimer measures from its construction to its destruction (one scope of a generator, see 'DATASET_PHASE')
+class dataset_detail::PhaseTimer
+{
+    // DATA MEMBERS //
+    private:
+        Phase phase;                                       //What is being measured
+        std::uint64_t elements, bytes;                    //How much of it
+        std::chrono::steady_clock::time_point start;     //When it started
+        std::uint64_t cacheStart, branchStart;          //Hardware counts when it started
+
+    // FUNCTION MEMBERS //
+    public:
+        //Public special methods
+        PhaseTimer(const Phase, const std::uint64_t, const std::uint64_t);     //phase, elements, bytes
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+        ~PhaseTimer();
+};
+
+//Start measuring
+inline dataset_detail::PhaseTimer::PhaseTimer(const Phase phase, const std::uint64_t elements, const std::uint64_t bytes): phase(phase), elements(elements), bytes(bytes),
+    cacheStart(0), branchStart(0)
+{
+#if defined(DATASET_PERF_EVENTS)
+    cacheStart = perfCounters().cacheMisses();
+    branchStart = perfCounters().branchMisses();
+#endif
+
+    start = std::chrono::steady_clock::now();
+}
+
+//Add to the phase's totals
+inline dataset_detail::PhaseTimer::~PhaseTimer()
+{
+    const auto stop = std::chrono::steady_clock::now();
+    PhaseTotals& totals = phaseTotals[static_cast<size_t>(phase)];
+
+#if defined(DATASET_PERF_EVENTS)
+    totals.cacheMisses.fetch_add(perfCounters().cacheMisses() - cacheStart, std::memory_order_relaxed);
+    totals.branchMisses.fetch_add(perfCounters().branchMisses() - branchStart, std::memory_order_relaxed);
+    if (perfCounters().active())
+        totals.counted.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    totals.calls.fetch_add(1, std::memory_order_relaxed);
+    totals.nanoseconds.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()), std::memory_order_relaxed);
+    totals.elements.fetch_add(elements, std::memory_order_relaxed);
+    totals.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+#endif
+
+
+/*
+    +----------------------------+
+    |  Generation Implementation |
+    +----------------------------+
+*/
+
+//Generate random data (for: RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED)
+template <DT dataT, typename T, typename Engine>
+void dataset_detail::genRandomData(T* dataset, const size_t size, const T min, const T max, Engine& RNG)
+{
+    checkRange(min, max);
+    DATASET_PHASE(Phase::RANDOM, size, size * sizeof(T));
+
+    //Sorted? Reverse sorted? Generate the values in order, in O(n), instead of sorting random ones
+    if constexpr (dataT == DT::SORTED or dataT == DT::REVERSE_SORTED or dataT == DT::NEARLY_SORTED)
+    {
+        const KeyMap<T> keys(min, max);
+
+        if (keys.enumerable())
+        {
+            //Kept per thread, so regenerating a dataset reuses the bucket storage
+            thread_local SortedPlan<typename KeyMap<T>::Key> plan;
+            plan.reset(size, keys.lowest(), keys.highest());
+            plan.distribute([&](const size_t, const size_t elements, const double p) { return std::binomial_distribution<size_t>(elements, p)(RNG); });
+
+            fillSorted<dataT == DT::REVERSE_SORTED>(dataset, 0, size, plan, [&](const size_t, const size_t) { return [&]() { return draw64(RNG); }; }, keys);
+        }
+        else
+        {
+            //128-bit ranges too wide for 64-bit keys: draw, then sort
+            for(size_t i=0; i < size; i++)
+                dataset[i] = drawValue(min, max, RNG);
+
+            DATASET_PHASE(Phase::SORT, size, size * sizeof(T));
+            if constexpr (dataT == DT::REVERSE_SORTED)
+                std::sort(dataset, dataset + size, std::greater<T>());
+            else
+                std::sort(dataset, dataset + size, std::less<T>());
+        }
+
+        //Nearly sorted?
+        if constexpr (dataT == DT::NEARLY_SORTED)
+            perturbData(dataset, size, RNG);
+    }
+    else if constexpr (std::is_same<T, float>::value)
+    {
+        //Two floats per 64-bit draw
+        const float width = max - min;
+        size_t i = 0;
+
+        for(; i + 1 < size; i += 2)
+        {
+            const std::uint64_t draw = draw64(RNG);
+            dataset[i] = min + unitFloat(static_cast<std::uint32_t>(draw)) * width;
+            dataset[i + 1] = min + unitFloat(static_cast<std::uint32_t>(draw >> 32)) * width;
+        }
+
+        if (i < size)
+            dataset[i] = min + unitFloat(static_cast<std::uint32_t>(draw64(RNG))) * width;
+    }
+    else if constexpr (isReal<T> or isWide<T>::value)
+    {
+        //One 64-bit draw per double, two per 128-bit integer
+        for(size_t i=0; i < size; i++)
+            dataset[i] = drawValue(min, max, RNG);
+    }
+    else
+    {
+        //Apply distribution
+        std::uniform_int_distribution<T> distribution(min, max);
+
+        //Fill the array with random values
+        for(size_t i=0; i < size; i++)
+        {
+            //Generate a random value between the minimum and maximum
+            dataset[i] = distribution(RNG);
+        }
+    }
+}
+
+//Generate random data on several threads (for: RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED)
+template <DT dataT, typename T>
+void dataset_detail::genRandomDataParallel(T* dataset, const size_t size, const T min, const T max, const Parallel parallel)
+{
+    checkRange(min, max);
+    DATASET_PHASE(Phase::RANDOM, size, size * sizeof(T));
+
+    if constexpr (dataT == DT::SORTED or dataT == DT::REVERSE_SORTED or dataT == DT::NEARLY_SORTED)
+    {
+        const KeyMap<T> keys(min, max);
+
+        if (keys.enumerable())
+        {
+            //Each split and each bucket has its own sub-stream of the seed, so the threads only have to agree on the bucket sizes
+            thread_local SortedPlan<typename KeyMap<T>::Key> reused;     //Reused by the next dataset this thread generates
+            SortedPlan<typename KeyMap<T>::Key>& plan = reused;        //(the workers must read this thread's plan, not their own)
+            seededPlan(plan, size, keys.lowest(), keys.highest(), parallel.seed);
+
+            parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+            {
+                fillSorted<dataT == DT::REVERSE_SORTED>(dataset + first, first, last - first, plan, [&](const size_t bucket, const size_t elements)
+                {
+                    return BucketDraws(parallel.seed, bucket, elements + 1);
+                }, keys);
+            });
+        }
+        else
+        {
+            //128-bit ranges too wide for 64-bit keys: draw in parallel, then sort
+            parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+            {
+                fillStream(dataset + first, first, last - first, min, max, parallel.seed, STREAM_VALUES);
+            });
+
+            DATASET_PHASE(Phase::SORT, size, size * sizeof(T));
+            if constexpr (dataT == DT::REVERSE_SORTED)
+                std::sort(dataset, dataset + size, std::greater<T>());
+            else
+                std::sort(dataset, dataset + size, std::less<T>());
+        }
+
+        //Nearly sorted? (the swaps come from their own stream of the same seed)
+        if constexpr (dataT == DT::NEARLY_SORTED)
+        {
+            Philox4x32 RNG(parallel.seed, STREAM_SWAPS);
+            perturbData(dataset, size, RNG);
+        }
+    }
+    else
+    {
+        //Element i is always drawn from position i of the seed's value stream, so how the array is split between threads can't change the output
+        parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+        {
+            fillStream(dataset + first, first, last - first, min, max, parallel.seed, STREAM_VALUES);
+        });
+    }
+}
+
+//Fill positions [first, first + count) of a sorted (or reverse sorted) dataset
+template <bool descending, typename T, typename Key, typename Source>
+void dataset_detail::fillSorted(T* dataset, const size_t first, const size_t count, const SortedPlan<Key>& plan, Source source, const KeyMap<T>& keys)
+{
+    if (count == 0)
+        return;
+
+    //Bucket b holds ascending positions [offset(b), offset(b + 1)); reverse sorted output mirrors them, so it walks the buckets top-down
+    const size_t size = plan.size();
+    const size_t last = first + count;
+    size_t bucket = plan.find(descending ? size - 1 - first : first);
+
+    for(size_t done=first; done < last; bucket = descending ? bucket - 1 : bucket + 1)
+    {
+        const size_t elements = plan.offset(bucket + 1) - plan.offset(bucket);
+        const size_t slot = descending ? size - plan.offset(bucket + 1) : plan.offset(bucket);
+        const size_t from = std::max(slot, first), to = std::min(slot + elements, last);
+
+        if (elements == 0)
+            continue;
+
+        //'source(bucket, elements)' gives the bucket's draws (at most elements + 1 of them), always in the same order, so a bucket cut by
+        //'first' or 'last' is generated whole and sliced. A single-value bucket needs none, so its draws are never generated (counting mode)
+        T* out = dataset + (from - first);
+
+        if (plan.width(bucket) == 1)
+            std::fill(out, out + (to - from), keys(plan.lowest(bucket)));
+        else if (from == slot and to == slot + elements and KeyMap<T>::direct)
+        {
+            auto draw = source(bucket, elements);
+            fillBucket(reinterpret_cast<Key*>(out), elements, plan.lowest(bucket), plan.width(bucket), descending, draw);    //'Key' is 'T'
+        }
+        else
+        {
+            auto draw = source(bucket, elements);
+            thread_local std::vector<Key> scratch;
+            scratch.resize(elements);
+
+            fillBucket(scratch.data(), elements, plan.lowest(bucket), plan.width(bucket), descending, draw);
+            std::transform(scratch.begin() + (from - slot), scratch.begin() + (to - slot), out, keys);
+        }
+
+        done = to;
+    }
+}
+
+//Fill one bucket with 'count' sorted (or reverse sorted) uniform values in [lowest, lowest + width)
+template <typename T, typename Draw>
+void dataset_detail::fillBucket(T* dataset, const size_t count, const T lowest, const std::uint64_t width, const bool descending, Draw& draw)
+{
+    using U = typename std::make_unsigned<T>::type;
+    const auto value = [&](const std::uint64_t offset) { return static_cast<T>(static_cast<U>(static_cast<U>(lowest) + static_cast<U>(offset))); };
+
+    //A single value: nothing to draw
+    if (width == 1)
+    {
+        std::fill(dataset, dataset + count, lowest);
+        return;
+    }
+
+    //Too wide for a double to tell neighbouring values apart: draw the bucket and sort it (a few thousand elements, in cache)
+    if (width == 0 or width > SPACING_LIMIT)
+    {
+        for(size_t k=0; k < count; k++)
+            dataset[k] = value(scale(draw(), width));
+
+        if (descending)
+            std::sort(dataset, dataset + count, std::greater<T>());
+        else
+            std::sort(dataset, dataset + count, std::less<T>());
+        return;
+    }
+
+    //Sorted uniforms from exponential spacings: with S(k) the running sum of Exp(1) draws, S(1)/S(count + 1) < ... < S(count)/S(count + 1)
+    //are distributed like 'count' sorted uniforms on [0, 1)
+    const auto spacing = [&]() { return -std::log(static_cast<double>((draw() >> 11) + 1) * 0x1p-53); };
+
+    thread_local std::vector<double> sums;
+    sums.resize(count);
+
+    double total = 0;
+    for(size_t k=0; k < count; k++)
+    {
+        total += spacing();
+        sums[k] = total;
+    }
+    total += spacing();
+
+    //Rounding only ever moves a value by one, and both the running sum and the scaling are monotonic, so the order survives
+    const double factor = static_cast<double>(width) / total;
+    for(size_t k=0; k < count; k++)
+    {
+        const std::uint64_t offset = std::min<std::uint64_t>(width - 1, static_cast<std::uint64_t>(sums[k] * factor));
+        dataset[descending ? count - 1 - k : k] = value(offset);
+    }
+}
+
+//Perturb a sorted dataset (for: NEARLY_SORTED)
+template <typename T, typename Engine>
+void dataset_detail::perturbData(T* dataset, const size_t size, Engine& RNG)
+{
+    //Mess up the order :D! (just a bit)
+    std::uniform_int_distribution<size_t> randomIndex(0, size-1);      //Random index generator
+    size_t amount = sqrt(sqrt(size));
+    DATASET_PHASE(Phase::PERTURB, size, size * sizeof(T));
+
+    for(size_t i=0; i < amount; i++)
+    {
+       //Swap two random element
+       std::swap(dataset[randomIndex(RNG)], dataset[randomIndex(RNG)]);
+    }
+}
+
+//Apply a disorder model
+template <typename T, typename Engine>
+void dataset_detail::perturbData(T* dataset, const size_t size, const Disorder& disorder, Engine& RNG)
+{
+    if (disorder.model == Perturbation::SWAPS and not (disorder.fraction >= 0 and disorder.fraction <= 1))
+        throw std::invalid_argument("invalid disorder; the fraction of swapped elements must be between 0 and 1.");
+
+    if ((disorder.model == Perturbation::WINDOW or disorder.model == Perturbation::RUNS) and disorder.window == 0)
+        throw std::invalid_argument("invalid disorder; the window must hold at least one element.");
+
+    if (size < 2)
+        return;
+
+    if (disorder.model == Perturbation::FEW_SWAPS)
+    {
+        perturbData(dataset, size, RNG);     //(which measures itself)
+        return;
+    }
+
+    DATASET_PHASE(Phase::PERTURB, size, size * sizeof(T));
+    if (disorder.model == Perturbation::SWAPS)
+    {
+        if (disorder.fraction == 0)
+            return;
+
+        //A swap moves two elements, so one starts at each position with probability fraction / 2 (the gaps between them are geometric)
+        std::geometric_distribution<size_t> gap(disorder.fraction / 2);
+        std::uniform_int_distribution<size_t> reach(1, disorder.window == 0 ? size - 1 : std::min(disorder.window, size - 1));
+        std::uniform_int_distribution<size_t> randomIndex(0, size-1);
+
+        for(size_t i = gap(RNG); i < size; i += 1 + gap(RNG))
+        {
+            //Bounded swaps only touch lines just ahead of the walk, which are still in cache
+            const size_t partner = disorder.window == 0 ? randomIndex(RNG) : i + std::min(reach(RNG), size - 1 - i);
+            std::swap(dataset[i], dataset[partner]);
+        }
+    }
+    else if (disorder.model == Perturbation::WINDOW)
+    {
+        //Shuffle consecutive blocks of 'window + 1' elements: nothing leaves its block, so nothing moves more than 'window' places
+        const size_t span = std::min(disorder.window, size - 1) + 1;
+
+        for(size_t block=0; block < size; block += std::min(span, size - block))
+            std::shuffle(dataset + block, dataset + block + std::min(span, size - block), RNG);
+    }
+    else
+    {
+        //Consecutive pairs of runs (1 to 'window' elements each) trade places: every pair leaves one descent, and elements move at most 'window' places
+        std::uniform_int_distribution<size_t> runLength(1, disorder.window);
+
+        for(size_t i=0; i < size;)
+        {
+            const size_t first = std::min(runLength(RNG), size - i);
+            const size_t second = std::min(runLength(RNG), size - i - first);
+
+            std::rotate(dataset + i, dataset + i + first, dataset + i + first + second);
+            i += first + second;
+        }
+    }
+}
+
+//Generate few-unique data (for: FEW_UNIQUE)
+template <typename T, typename Engine>
+void dataset_detail::genUniqueData(T* dataset, const size_t size, const T min, const T max, Engine& RNG)
+{
+    checkRange(min, max);
+    DATASET_PHASE(Phase::UNIQUE, size, size * sizeof(T));
+
+    /*
+        FEW_UNIQUE Implementation:
+        1. Draw {sqrt(size)} random values into a separate sample table (small enough to stay in cache)
+        2. Fill the dataset in one pass, each element a random pick from the table
+    */
+
+    //The amount of unique elements is the square root of the size of the dataset
+    const size_t amount = sqrt(size);     //Still using 'size_t' because the square root of 18.422 quintillion is still larger than max size of an int
+
+    //Populate the sample list with a few random values (kept per thread, so regenerating doesn't allocate)
+    thread_local std::vector<T> samples;
+    samples.resize(amount);
+    for(T& sample : samples)
+        sample = drawValue(min, max, RNG);
+
+    //Use the random sample to propagate the data (indices are 'size_t' so large datasets don't overflow a narrow 'T')
+    std::uniform_int_distribution<size_t> randomSampleIndex(0, amount-1);
+    for(size_t i=0; i < size; i++)
+        dataset[i] = samples[randomSampleIndex(RNG)];
+}
+
+//Generate few-unique data on several threads (for: FEW_UNIQUE)
+template <typename T>
+void dataset_detail::genUniqueDataParallel(T* dataset, const size_t size, const T min, const T max, const Parallel parallel)
+{
+    checkRange(min, max);
+    DATASET_PHASE(Phase::UNIQUE, size, size * sizeof(T));
+
+    //Every thread reads the same table; the picks come from their own positions of the seed's stream
+    thread_local std::vector<T> reused;     //Reused by the next dataset this thread generates
+    std::vector<T>& samples = reused;      //(the workers must read this thread's table, not their own)
+    uniqueSamples(samples, size, min, max, parallel.seed);
+
+    parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+    {
+        fillUnique(dataset + first, first, last - first, samples, parallel.seed);
+    });
+}
+
+//The few-unique sample table of a seed
+template <typename T>
+void dataset_detail::uniqueSamples(std::vector<T>& samples, const size_t size, const T min, const T max, const std::uint64_t seed)
+{
+    samples.resize(static_cast<size_t>(sqrt(size)));
+    fillStream(samples.data(), 0, samples.size(), min, max, seed, subStream(STREAM_UNIQUE, 0));
+}
+
+//Few-unique elements [first, first + count): element i is 'samples[pick i]'
+template <typename T>
+void dataset_detail::fillUnique(T* dataset, const std::uint64_t first, const size_t count, const std::vector<T>& samples, const std::uint64_t seed)
+{
+    //At most 2^32 samples (the square root of the largest size), so the picks come from the bulk kernel in 32-bit form
+    const std::uint32_t last = static_cast<std::uint32_t>(samples.size() - 1);
+    std::uint32_t picks[2 * KERNEL_CHUNK];
+
+    for(size_t done=0; done < count; done += 2 * KERNEL_CHUNK)
+    {
+        const size_t amount = std::min(2 * KERNEL_CHUNK, count - done);
+        fillStream<std::uint32_t>(picks, first + done, amount, 0, last, seed, subStream(STREAM_UNIQUE, 1));
+
+        for(size_t k=0; k < amount; k++)
+            dataset[done + k] = samples[picks[k]];
+    }
+}
+
+//Validate a range for different values (for: PERMUTATION, DISTINCT)
+template <typename T>
+constexpr void dataset_detail::checkDistinct(const DT type, const size_t size, const T min, const T max)
+{
+    if (type != DT::PERMUTATION and type != DT::DISTINCT)
+        return;
+
+    if constexpr (isReal<T>)
+        throw std::invalid_argument("invalid type; PERMUTATION and DISTINCT datasets must be integral.");
+    else
+    {
+        //[min, max] must hold 'size' values (a permutation is the first 'size' of them)
+        using U = typename unsignedOf<T>::type;
+        const U width = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+        bool fits = true, enumerable = true;
+
+        if constexpr (isWide<T>::value)
+        {
+            fits = size == 0 or width >= static_cast<U>(size - 1);
+            enumerable = width >> 64 == 0;     //(what 'KeyMap::enumerable()' checks)
+        }
+        else
+            fits = size == 0 or static_cast<std::uint64_t>(width) >= size - 1;
+
+        if (not fits)
+            throw std::invalid_argument("invalid range; a PERMUTATION or DISTINCT dataset needs at least as many values in [min, max] as elements.");
+
+        if (type == DT::DISTINCT and not enumerable)
+            throw std::invalid_argument("invalid range; a DISTINCT dataset of 128-bit integers must span fewer than 2^64 values.");
+    }
+}
+
+//Generate different values (for: PERMUTATION, DISTINCT)
+template <DT dataT, typename T, typename Engine>
+void dataset_detail::genDistinctData(T* dataset, const size_t size, const T min, const T max, Engine& RNG)
+{
+    checkRange(min, max);
+    checkDistinct(dataT, size, min, max);
+    DATASET_PHASE(Phase::DISTINCT, size, size * sizeof(T));
+
+    if constexpr (dataT == DT::PERMUTATION)
+    {
+        using U = typename unsignedOf<T>::type;
+        for(size_t i=0; i < size; i++)
+            dataset[i] = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(i)));
+    }
+    else
+    {
+        /*
+            DISTINCT Implementation:
+            1. Split the range into buckets, and the elements between them without replacement (hypergeometric splits, as the sorted types split theirs)
+            2. Each bucket picks its share with Floyd's algorithm (every draw chooses a new value: no draws are rejected as duplicates)
+            3. Shuffle, so the buckets' values are spread over the whole array
+        */
+        const KeyMap<T> keys(min, max);
+        using Key = typename KeyMap<T>::Key;
+        const auto draw = [&]() { return draw64(RNG); };
+
+        thread_local SortedPlan<Key> plan;     //Reused by the next dataset this thread generates
+        plan.reset(size, keys.lowest(), keys.highest());
+        plan.choose([&](const size_t, const size_t elements, const std::uint64_t left, const std::uint64_t right)
+        {
+            return hypergeometric(left, right, elements, unitDouble(draw64(RNG)));
+        });
+
+        for(size_t b=0; b < plan.buckets(); b++)
+        {
+            //Keys are the values unless T is a 128-bit integer
+            const size_t elements = plan.offset(b + 1) - plan.offset(b);
+            if constexpr (KeyMap<T>::direct)
+                sampleBucket(dataset + plan.offset(b), elements, plan.lowest(b), plan.width(b), draw);
+            else
+            {
+                thread_local std::vector<Key> scratch;
+                scratch.resize(elements);
+
+                sampleBucket(scratch.data(), elements, plan.lowest(b), plan.width(b), draw);
+                std::transform(scratch.begin(), scratch.end(), dataset + plan.offset(b), keys);
+            }
+        }
+    }
+
+    {
+        DATASET_PHASE(Phase::SHUFFLE, size, size * sizeof(T));
+        fisherYates(dataset, size, RNG);
+    }
+}
+
+//Generate different values on several threads (for: PERMUTATION, DISTINCT)
+template <DT dataT, typename T>
+void dataset_detail::genDistinctDataParallel(T* dataset, const size_t size, const T min, const T max, const Parallel parallel)
+{
+    checkRange(min, max);
+    checkDistinct(dataT, size, min, max);
+    DATASET_PHASE(Phase::DISTINCT, size, size * sizeof(T));
+
+    //The shuffle asks for the unshuffled elements a slice at a time ('source(out, first, count)'), and only once each
+    if constexpr (dataT == DT::PERMUTATION)
+    {
+        shuffleParallel(dataset, size, parallel.seed, parallel.threads, [&]()
+        {
+            return [&](T* out, const size_t first, const size_t count)
+            {
+                using U = typename unsignedOf<T>::type;
+                for(size_t k=0; k < count; k++)
+                    out[k] = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(first + k)));
+            };
+        });
+    }
+    else
+    {
+        //Unshuffled, the elements are the buckets' samples one after the other; each bucket samples from its own sub-stream
+        const KeyMap<T> keys(min, max);
+        using Key = typename KeyMap<T>::Key;
+
+        thread_local SortedPlan<Key> reused;     //Reused by the next dataset this thread generates
+        SortedPlan<Key>& plan = reused;         //(the workers must read this thread's plan, not their own)
+        seededChoice(plan, size, keys.lowest(), keys.highest(), parallel.seed);
+
+        shuffleParallel(dataset, size, parallel.seed, parallel.threads, [&]()
+        {
+            //One source per worker: it keeps the last bucket it sampled, since a bucket usually spans several slices
+            return [&, held = plan.buckets()](T* out, const size_t first, const size_t count) mutable
+            {
+                thread_local std::vector<Key> scratch;
+
+                for(size_t done=first; done < first + count;)
+                {
+                    const size_t bucket = plan.find(done);
+                    const size_t slot = plan.offset(bucket), to = std::min(plan.offset(bucket + 1), first + count);
+
+                    if (bucket != held)
+                    {
+                        StreamEngine draw(parallel.seed, subStream(STREAM_SAMPLES, bucket));
+                        scratch.resize(plan.offset(bucket + 1) - slot);
+                        sampleBucket(scratch.data(), scratch.size(), plan.lowest(bucket), plan.width(bucket), draw);
+                        held = bucket;
+                    }
+
+                    std::transform(scratch.begin() + (done - slot), scratch.begin() + (to - slot), out + (done - first), keys);
+                    done = to;
+                }
+            };
+        });
+    }
+}
+
+//Floyd's algorithm: for j = width - count ... width - 1, pick t in [0, j]; take t, or j if t was already taken (j never was). Every subset of
+//'count' values is equally likely, with exactly one draw per value
+template <typename T, typename Draw>
+void dataset_detail::sampleBucket(T* dataset, const size_t count, const T lowest, const std::uint64_t width, Draw& draw)
+{
+    using U = typename std::make_unsigned<T>::type;
+    const auto value = [&](const std::uint64_t offset) { return static_cast<T>(static_cast<U>(static_cast<U>(lowest) + static_cast<U>(offset))); };
+    const std::uint64_t first = width - count;     //(wraps correctly for a 2^64-value bucket, whose width is 0)
+
+    if (width != 0 and width / SAMPLE_BITMAP <= count)
+    {
+        //Dense: one bit per value
+        thread_local std::vector<std::uint64_t> taken;
+        taken.assign(static_cast<size_t>((width + 63) / 64), 0);
+
+        for(size_t k=0; k < count; k++)
+        {
+            const std::uint64_t j = first + k, t = scale(draw(), j + 1);
+            const std::uint64_t pick = taken[t / 64] >> (t % 64) & 1 ? j : t;
+
+            taken[pick / 64] |= std::uint64_t(1) << (pick % 64);
+            dataset[k] = value(pick);
+        }
+    }
+    else
+    {
+        //Sparse: an open-addressing hash set, at most half full (slots hold offset + 1, so 0 is empty; offset 2^64 - 1 is tracked apart)
+        thread_local std::vector<std::uint64_t> slots;
+        size_t capacity = 2;
+        while (capacity < 2 * count)
+            capacity <<= 1;
+        slots.assign(capacity, 0);
+
+        bool top = false;
+        const auto insert = [&](const std::uint64_t offset)     //false if already taken
+        {
+            if (offset == std::numeric_limits<std::uint64_t>::max())
+                return not top and (top = true);
+
+            size_t slot = static_cast<size_t>((offset * 0x9E3779B97F4A7C15u) >> 32) & (capacity - 1);
+            for(; slots[slot] != 0; slot = (slot + 1) & (capacity - 1))
+                if (slots[slot] == offset + 1)
+                    return false;
+
+            slots[slot] = offset + 1;
+            return true;
+        };
+
+        for(size_t k=0; k < count; k++)
+        {
+            const std::uint64_t j = first + k, t = scale(draw(), j + 1);
+            const std::uint64_t pick = insert(t) ? t : j;
+
+            if (pick == j)
+                insert(j);
+            dataset[k] = value(pick);
+        }
+    }
+}
+
+//Fisher-Yates: position i - 1 swaps with a uniform position in [0, i)
+template <typename T, typename Engine>
+void dataset_detail::fisherYates(T* dataset, const size_t size, Engine& RNG)
+{
+    for(size_t i=size; i > 1; i--)
+        std::swap(dataset[i - 1], dataset[scale(draw64(RNG), i)]);
+}
+
+//Parallel shuffle (Sanders, "Random permutations on distributed, external and hierarchical memory"): send every element to a uniformly random
+//bucket, then shuffle each bucket. Any order in, a uniformly random order out; 'makeSource()' gives each worker a 'source(out, first, count)'
+template <typename T, typename Source>
+void dataset_detail::shuffleParallel(T* dataset, const size_t size, const std::uint64_t seed, const unsigned threads, Source makeSource)
+{
+    DATASET_PHASE(Phase::SHUFFLE, size, size * sizeof(T));
+
+    size_t buckets = 1;
+    while (buckets < SHUFFLE_MAX_BUCKETS and size / buckets > SHUFFLE_BUCKET)
+        buckets <<= 1;
+
+    if (buckets == 1)
+    {
+        StreamEngine RNG(seed, subStream(STREAM_SHUFFLE, 1));
+        makeSource()(dataset, 0, size);
+        fisherYates(dataset, size, RNG);
+        return;
+    }
+
+    //Fixed blocks of the input count their elements per bucket; a bucket then holds block 0's elements, block 1's, ... So every bucket's
+    //elements arrive in input order, however the blocks are split between threads
+    const size_t blocks = std::min(SHUFFLE_BLOCKS, size / SHUFFLE_BUCKET);
+    const auto block = [&](const size_t b) { return size / blocks * b + std::min(b, size % blocks); };    //Block b starts here
+    const auto eachBlock = [&](const size_t first, const size_t last, auto function)    //Every block that starts in [first, last)
+    {
+        for(size_t b = first / (size / blocks + 1); b < blocks and block(b) < last; b++)     //(no block is longer than size / blocks + 1)
+            if (block(b) >= first)
+                function(b, block(b), block(b + 1));
+    };
+
+    thread_local std::vector<size_t> reusedCursors, reusedStarts;    //Reused by the next dataset this thread generates
+    std::vector<size_t>& cursors = reusedCursors;                   //(the workers must read this thread's tables, not their own)
+    std::vector<size_t>& starts = reusedStarts;
+    cursors.assign(blocks * buckets, 0);
+    starts.resize(buckets + 1);
+
+    //Element i goes to bucket 'pick i' of sub-stream 0
+    const auto picks = [&](std::uint32_t* out, const size_t first, const size_t count)
+    {
+        fillStream<std::uint32_t>(out, first, count, 0, static_cast<std::uint32_t>(buckets - 1), seed, subStream(STREAM_SHUFFLE, 0));
+    };
+
+    parallelFor(size, threads, [&](const size_t first, const size_t last)
+    {
+        std::uint32_t to[2 * KERNEL_CHUNK];
+        eachBlock(first, last, [&](const size_t b, const size_t from, const size_t until)
+        {
+            size_t* counts = cursors.data() + b * buckets;
+            for(size_t done=from; done < until; done += 2 * KERNEL_CHUNK)
+            {
+                const size_t amount = std::min(2 * KERNEL_CHUNK, until - done);
+                picks(to, done, amount);
+
+                for(size_t k=0; k < amount; k++)
+                    counts[to[k]]++;
+            }
+        });
+    });
+
+    //Counts -> where each block's share of each bucket starts
+    size_t position = 0;
+    for(size_t bucket=0; bucket < buckets; bucket++)
+    {
+        starts[bucket] = position;
+        for(size_t b=0; b < blocks; b++)
+        {
+            const size_t count = cursors[b * buckets + bucket];
+            cursors[b * buckets + bucket] = position;
+            position += count;
+        }
+    }
+    starts[buckets] = size;
+
+    //Scatter (the picks are drawn again: cheaper than storing them)
+    parallelFor(size, threads, [&](const size_t first, const size_t last)
+    {
+        std::uint32_t to[2 * KERNEL_CHUNK];
+        T values[2 * KERNEL_CHUNK];
+        auto source = makeSource();
+
+        eachBlock(first, last, [&](const size_t b, const size_t from, const size_t until)
+        {
+            size_t* cursor = cursors.data() + b * buckets;
+            for(size_t done=from; done < until; done += 2 * KERNEL_CHUNK)
+            {
+                const size_t amount = std::min(2 * KERNEL_CHUNK, until - done);
+                picks(to, done, amount);
+                source(values, done, amount);
+
+                for(size_t k=0; k < amount; k++)
+                    dataset[cursor[to[k]]++] = values[k];
+            }
+        });
+    });
+
+    //Shuffle every bucket (in cache), each from its own sub-stream; a worker takes the buckets that start in its range
+    parallelFor(size, threads, [&](const size_t first, const size_t last)
+    {
+        const size_t from = static_cast<size_t>(std::lower_bound(starts.begin(), starts.begin() + buckets, first) - starts.begin());
+        const size_t until = static_cast<size_t>(std::lower_bound(starts.begin(), starts.begin() + buckets, last) - starts.begin());
+
+        for(size_t bucket=from; bucket < until; bucket++)
+        {
+            StreamEngine RNG(seed, subStream(STREAM_SHUFFLE, 1 + bucket));
+            fisherYates(dataset + starts[bucket], starts[bucket + 1] - starts[bucket], RNG);
+        }
+    });
+}
+
+//The worst-case patterns
+constexpr bool dataset_detail::isPattern(const DT type) noexcept
+{
+    return type == DT::ORGAN_PIPE or type == DT::SAWTOOTH or type == DT::PUSH_FRONT or type == DT::PUSH_BACK or type == DT::ALL_EQUAL;
+}
+
+//Elements per SAWTOOTH run
+constexpr size_t dataset_detail::toothLength(const size_t size) noexcept
+{
+    return std::max<size_t>(1, rootOf(size));
+}
+
+//Generate a worst-case pattern (for: ORGAN_PIPE, SAWTOOTH, PUSH_FRONT, PUSH_BACK, ALL_EQUAL)
+template <DT dataT, typename T, typename Engine>
+void dataset_detail::genPatternData(T* dataset, const size_t size, const T min, const T max, Engine& RNG)
+{
+    checkRange(min, max);
+
+    //Every pattern but ALL_EQUAL is made of sorted runs, each generated in O(n) like a SORTED dataset of its own
+    if constexpr (dataT == DT::ALL_EQUAL)
+        std::fill(dataset, dataset + size, drawValue(min, max, RNG));
+    else if constexpr (dataT == DT::ORGAN_PIPE)
+    {
+        const size_t rising = size - size / 2;
+        genRandomData<DT::SORTED>(dataset, rising, min, max, RNG);
+        genRandomData<DT::REVERSE_SORTED>(dataset + rising, size / 2, min, max, RNG);
+    }
+    else if constexpr (dataT == DT::SAWTOOTH)
+    {
+        const size_t tooth = toothLength(size);
+        for(size_t first=0; first < size; first += tooth)
+            genRandomData<DT::SORTED>(dataset + first, std::min(tooth, size - first), min, max, RNG);
+    }
+    else
+    {
+        //Pushed? Sorted, then one end moves to the other (a single memmove)
+        genRandomData<DT::SORTED>(dataset, size, min, max, RNG);
+        if constexpr (dataT == DT::PUSH_FRONT)
+            std::rotate(dataset, dataset + 1, dataset + size);
+        else
+            std::rotate(dataset, dataset + size - 1, dataset + size);
+    }
+}
+
+//Generate a worst-case pattern on several threads (for: ORGAN_PIPE, SAWTOOTH, PUSH_FRONT, PUSH_BACK, ALL_EQUAL)
+template <DT dataT, typename T>
+void dataset_detail::genPatternDataParallel(T* dataset, const size_t size, const T min, const T max, const Parallel parallel)
+{
+    checkRange(min, max);
+
+    if constexpr (dataT == DT::ALL_EQUAL)
+    {
+        //Element 0 of the value stream, everywhere
+        T value;
+        fillStream(&value, 0, 1, min, max, parallel.seed, STREAM_VALUES);
+
+        parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+        {
+            std::fill(dataset + first, dataset + last, value);
+        });
+    }
+    else if constexpr (dataT == DT::ORGAN_PIPE)
+    {
+        //Each half is a sorted dataset of its own seed, made on every thread
+        const size_t rising = size - size / 2;
+        genRandomDataParallel<DT::SORTED>(dataset, rising, min, max, Parallel{runSeed(parallel.seed, 0), parallel.threads});
+        genRandomDataParallel<DT::REVERSE_SORTED>(dataset + rising, size / 2, min, max, Parallel{runSeed(parallel.seed, 1), parallel.threads});
+    }
+    else if constexpr (dataT == DT::SAWTOOTH)
+    {
+        //Runs are small ({sqrt(size)} elements): a worker makes the runs that start in its range, each with one thread and its own seed
+        const size_t tooth = toothLength(size);
+
+        parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+        {
+            for(size_t run = (first + tooth - 1) / tooth; run * tooth < last; run++)
+            {
+                const size_t start = run * tooth;
+                genRandomDataParallel<DT::SORTED>(dataset + start, std::min(tooth, size - start), min, max, Parallel{runSeed(parallel.seed, run), 1});
+            }
+        });
+    }
+    else
+    {
+        genRandomDataParallel<DT::SORTED>(dataset, size, min, max, parallel);
+        if constexpr (dataT == DT::PUSH_FRONT)
+            std::rotate(dataset, dataset + 1, dataset + size);
+        else
+            std::rotate(dataset, dataset + size - 1, dataset + size);
+    }
+}
+
+//Sort values into a pattern (for: ORGAN_PIPE, SAWTOOTH, PUSH_FRONT, PUSH_BACK, ALL_EQUAL)
+template <DT dataT, typename T>
+void dataset_detail::arrangeData(T* dataset, const size_t size)
+{
+    if (size == 0)
+        return;
+
+    DATASET_PHASE(Phase::SORT, size, size * sizeof(T));
+
+    if constexpr (dataT == DT::ALL_EQUAL)
+        std::fill(dataset + 1, dataset + size, dataset[0]);
+    else if constexpr (dataT == DT::ORGAN_PIPE)
+    {
+        const size_t rising = size - size / 2;
+        std::sort(dataset, dataset + rising, std::less<T>());
+        std::sort(dataset + rising, dataset + size, std::greater<T>());
+    }
+    else if constexpr (dataT == DT::SAWTOOTH)
+    {
+        const size_t tooth = toothLength(size);
+        for(size_t first=0; first < size; first += tooth)
+            std::sort(dataset + first, dataset + std::min(first + tooth, size), std::less<T>());
+    }
+    else
+    {
+        std::sort(dataset, dataset + size, std::less<T>());
+        if constexpr (dataT == DT::PUSH_FRONT)
+            std::rotate(dataset, dataset + 1, dataset + size);
+        else
+            std::rotate(dataset, dataset + size - 1, dataset + size);
+    }
+}
+
+//McIlroy's adversary ("A Killer Adversary for Quicksort", 1999): every element starts as "gas", above every solid value. Comparing two gas elements
+//freezes the one that isn't the likely pivot to the next solid value, so the pivots keep turning out to be the smallest elements left. The ranks
+//a sort leaves behind are an input it handles exactly as badly again; the cost is that of the sort itself (quadratic for a quicksort it defeats)
+template <typename Sort>
+void dataset_detail::antiQuicksort(std::vector<size_t>& ranks, const size_t size, Sort sort)
+{
+    const size_t gas = size;
+    size_t solid = 0, candidate = 0;
+    ranks.assign(size, gas);
+
+    std::vector<size_t> items(size);
+    std::iota(items.begin(), items.end(), size_t(0));
+
+    sort(items.data(), items.data() + size, [&](const size_t x, const size_t y)
+    {
+        if (ranks[x] == gas and ranks[y] == gas)
+            ranks[x == candidate ? x : y] = solid++;
+
+        if (ranks[x] == gas)
+            candidate = x;
+        else if (ranks[y] == gas)
+            candidate = y;
+
+        return ranks[x] < ranks[y];
+    });
+
+    //Elements still gas were never told apart: any order of them is as bad
+    for(size_t& rank : ranks)
+    {
+        if (rank == gas)
+            rank = solid++;
+    }
+}
+
+//Generate a new dataset in a constant expression (for: every DT)
+template <DT dataT, typename T>
+constexpr void dataset_detail::genConstantData(T* dataset, const size_t size, const T min, const T max, const std::uint64_t seed)
+{
+    checkRange(min, max);
+    SplitMix64 RNG(seed);
+
+    if constexpr (dataT == DT::PERMUTATION or dataT == DT::DISTINCT)
+    {
+        using U = typename unsignedOf<T>::type;
+        checkDistinct(dataT, size, min, max);
+
+        if constexpr (dataT == DT::PERMUTATION)
+        {
+            for(size_t i=0; i < size; i++)
+                dataset[i] = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(i)));
+        }
+        else
+        {
+            //Floyd's algorithm (see 'sampleBucket()') with the chosen values kept sorted for the membership test: O(n^2) moves, so compile-time
+            //DISTINCT datasets have to stay smaller than the other types
+            const U width = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+            const auto value = [&](const U offset) { return static_cast<T>(static_cast<U>(static_cast<U>(min) + offset)); };
+
+            for(size_t k=0; k < size; k++)
+            {
+                const U j = static_cast<U>(width - static_cast<U>(size - 1 - k));
+                const T drawn = value(constantValue<U>(0, j, RNG));
+
+                size_t low = 0, high = k;
+                while (low < high)
+                {
+                    const size_t middle = low + (high - low) / 2;
+                    if (dataset[middle] < drawn)
+                        low = middle + 1;
+                    else
+                        high = middle;
+                }
+
+                //Already chosen? Then j (which can't have been)
+                const T pick = low < k and dataset[low] == drawn ? value(j) : drawn;
+                size_t slot = k;
+                for(; slot > 0 and pick < dataset[slot - 1]; slot--)
+                    dataset[slot] = dataset[slot - 1];
+                dataset[slot] = pick;
+            }
+        }
+
+        for(size_t i=size; i > 1; i--)
+            exchange(dataset[i - 1], dataset[scale(RNG(), i)]);
+    }
+    else if constexpr (dataT == DT::FEW_UNIQUE)
+    {
+        //There is no room for a separate sample table: the {sqrt(size)} samples come first, the picks from them after, then everything is shuffled
+        const size_t amount = rootOf(size);
+
+        for(size_t i=0; i < amount; i++)
+            dataset[i] = constantValue(min, max, RNG);
+
+        for(size_t i=amount; i < size; i++)
+            dataset[i] = dataset[scale(RNG(), amount)];
+
+        for(size_t i=size; i > 1; i--)
+            exchange(dataset[i - 1], dataset[scale(RNG(), i)]);
+    }
+    else if constexpr (dataT == DT::ALL_EQUAL)
+    {
+        const T value = constantValue(min, max, RNG);
+        for(size_t i=0; i < size; i++)
+            dataset[i] = value;
+    }
+    else
+    {
+        for(size_t i=0; i < size; i++)
+            dataset[i] = constantValue(min, max, RNG);
+
+        if constexpr (dataT == DT::SORTED or dataT == DT::NEARLY_SORTED or dataT == DT::PUSH_FRONT or dataT == DT::PUSH_BACK)
+            heapSort<false>(dataset, size);
+        else if constexpr (dataT == DT::REVERSE_SORTED)
+            heapSort<true>(dataset, size);
+        else if constexpr (dataT == DT::ORGAN_PIPE)
+        {
+            heapSort<false>(dataset, size - size / 2);
+            heapSort<true>(dataset + (size - size / 2), size / 2);
+        }
+        else if constexpr (dataT == DT::SAWTOOTH)
+        {
+            for(size_t first=0, tooth = toothLength(size); first < size; first += tooth)
+                heapSort<false>(dataset + first, std::min(tooth, size - first));
+        }
+
+        //Pushed? One end moves to the other, everything else one place over ('std::rotate()' isn't 'constexpr' before C++20)
+        if constexpr (dataT == DT::PUSH_FRONT)
+        {
+            const T smallest = dataset[0];
+            for(size_t i=1; i < size; i++)
+                dataset[i - 1] = dataset[i];
+            dataset[size - 1] = smallest;
+        }
+        else if constexpr (dataT == DT::PUSH_BACK)
+        {
+            const T largest = dataset[size - 1];
+            for(size_t i=size - 1; i > 0; i--)
+                dataset[i] = dataset[i - 1];
+            dataset[0] = largest;
+        }
+
+        //Nearly sorted? The same {sqrt(sqrt(size))} random swaps as 'perturbData()'
+        if constexpr (dataT == DT::NEARLY_SORTED)
+        {
+            for(size_t i=0, amount = rootOf(rootOf(size)); i < amount; i++)
+                exchange(dataset[scale(RNG(), size)], dataset[scale(RNG(), size)]);
+        }
+    }
+}
+
+//One uniform value (the same formulas as 'drawValue()' for floating point and 128-bit integers)
+template <typename T>
+constexpr T dataset_detail::constantValue(const T min, const T max, SplitMix64& RNG) noexcept
+{
+    if constexpr (isReal<T>)
+        return min + static_cast<T>(static_cast<double>(RNG() >> 12) * 0x1p-52) * (max - min);    //'unitDouble()' without the 'memcpy()'
+    else if constexpr (isWide<T>::value)
+    {
+        using U = typename unsignedOf<T>::type;
+        const U draw = static_cast<U>(RNG()) << 64 | RNG();
+        return static_cast<T>(static_cast<U>(static_cast<U>(min) + scaleWide(draw, static_cast<U>(static_cast<U>(max) - static_cast<U>(min)) + 1)));
+    }
+    else
+    {
+        using U = typename unsignedOf<T>::type;
+        const std::uint64_t range = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(max) - static_cast<U>(min))) + 1;    //0 = all 2^64 values
+        return static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(scale(RNG(), range))));
+    }
+}
+
+//Heapsort: no recursion and no extra memory, and O(n log n) steps even on inputs that would trip up a quicksort
+template <bool descending, typename T>
+constexpr void dataset_detail::heapSort(T* dataset, const size_t size) noexcept
+{
+    //The heap keeps the element that belongs last on top
+    const auto before = [](const T& a, const T& b) { return descending ? b < a : a < b; };
+    const auto siftDown = [&](size_t root, const size_t end)
+    {
+        for(size_t child = 2 * root + 1; child < end; child = 2 * root + 1)
+        {
+            if (child + 1 < end and before(dataset[child], dataset[child + 1]))
+                child++;
+
+            if (not before(dataset[root], dataset[child]))
+                return;
+
+            exchange(dataset[root], dataset[child]);
+            root = child;
+        }
+    };
+
+    for(size_t i = size / 2; i > 0; i--)
+        siftDown(i - 1, size);
+
+    //Move the top to the end of the shrinking heap
+    for(size_t end = size; end > 1; end--)
+    {
+        exchange(dataset[0], dataset[end - 1]);
+        siftDown(0, end - 1);
+    }
+}
+
+//Swap two values
+template <typename T>
+constexpr void dataset_detail::exchange(T& a, T& b) noexcept
+{
+    const T temporary = a;
+    a = b;
+    b = temporary;
+}
+
+//Integer square root (Newton's method, so a constant expression only takes a few steps)
+constexpr size_t dataset_detail::rootOf(const size_t value) noexcept
+{
+    if (value < 2)
+        return value;
+
+    size_t root = value, next = value / 2 + 1;
+    while (next < root)
+    {
+        root = next;
+        next = (root + value / root) / 2;
+    }
+
+    return root;
+}
+
+//One distribution sample in [min, max]
+template <typename T, typename Engine>
+T dataset_detail::shapedValue(const Distribution& distribution, const T min, const T max, Engine& RNG)
+{
+    //Out-of-range samples are drawn again (a truncated distribution); a range the distribution hardly reaches gets clamped values instead of looping
+    const double low = static_cast<double>(min), high = static_cast<double>(max);
+    double value = 0;
+
+    for(int tries=0; tries < SHAPED_TRIES; tries++)
+    {
+        value = distribution(RNG);
+        if constexpr (not isReal<T>)
+            value = std::floor(value + 0.5);     //Nearest integer
+
+        if (value >= low and value <= high)
+            break;
+    }
+
+    //'high' may have rounded above 'max' (64-bit integers), so the ends come from 'min'/'max' themselves
+    if (not (value > low))
+        return min;
+    if (not (value < high))
+        return max;
+    return static_cast<T>(value);
+}
+
+//Generate data with a distribution's values (for: every DT)
+template <DT dataT, typename T, typename Engine>
+void dataset_detail::genShapedData(T* dataset, const size_t size, const T min, const T max, const Distribution& distribution, Engine& RNG)
+{
+    static_assert(dataT != DT::PERMUTATION and dataT != DT::DISTINCT, "PERMUTATION and DISTINCT datasets can't follow a distribution (their values are fixed, or uniform without replacement)");
+    checkRange(min, max);
+    DATASET_PHASE(Phase::SHAPED, size, size * sizeof(T));
+
+    if constexpr (dataT == DT::FEW_UNIQUE)
+    {
+        //The sample table follows the distribution; the picks are uniform
+        thread_local std::vector<T> samples;
+        samples.resize(static_cast<size_t>(sqrt(size)));
+        for(T& sample : samples)
+            sample = shapedValue(distribution, min, max, RNG);
+
+        std::uniform_int_distribution<size_t> randomSampleIndex(0, samples.size()-1);
+        for(size_t i=0; i < size; i++)
+            dataset[i] = samples[randomSampleIndex(RNG)];
+    }
+    else
+    {
+        for(size_t i=0; i < size; i++)
+            dataset[i] = shapedValue(distribution, min, max, RNG);
+
+        //No O(n) sorted generation for an arbitrary shape: sort what was drawn
+        if constexpr (isPattern(dataT))
+            arrangeData<dataT>(dataset, size);
+        else if constexpr (dataT != DT::RANDOM)
+        {
+            DATASET_PHASE(Phase::SORT, size, size * sizeof(T));
+            if constexpr (dataT == DT::REVERSE_SORTED)
+                std::sort(dataset, dataset + size, std::greater<T>());
+            else
+                std::sort(dataset, dataset + size, std::less<T>());
+        }
+
+        if constexpr (dataT == DT::NEARLY_SORTED)
+            perturbData(dataset, size, RNG);
+    }
+}
+
+//Generate data with a distribution's values on several threads (for: every DT)
+template <DT dataT, typename T>
+void dataset_detail::genShapedDataParallel(T* dataset, const size_t size, const T min, const T max, const Distribution& distribution, const Parallel parallel)
+{
+    static_assert(dataT != DT::PERMUTATION and dataT != DT::DISTINCT, "PERMUTATION and DISTINCT datasets can't follow a distribution (their values are fixed, or uniform without replacement)");
+    checkRange(min, max);
+    DATASET_PHASE(Phase::SHAPED, size, size * sizeof(T));
+
+    if constexpr (dataT == DT::FEW_UNIQUE)
+    {
+        thread_local std::vector<T> reused;     //Reused by the next dataset this thread generates
+        std::vector<T>& samples = reused;      //(the workers must read this thread's table, not their own)
+        samples.resize(static_cast<size_t>(sqrt(size)));
+        fillShaped(samples.data(), 0, samples.size(), min, max, distribution, parallel.seed);
+
+        parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+        {
+            fillUnique(dataset + first, first, last - first, samples, parallel.seed);
+        });
+    }
+    else
+    {
+        parallelFor(size, parallel.threads, [&](const size_t first, const size_t last)
+        {
+            fillShaped(dataset + first, first, last - first, min, max, distribution, parallel.seed);
+        });
+
+        if constexpr (isPattern(dataT))
+            arrangeData<dataT>(dataset, size);
+        else if constexpr (dataT != DT::RANDOM)
+        {
+            DATASET_PHASE(Phase::SORT, size, size * sizeof(T));
+            if constexpr (dataT == DT::REVERSE_SORTED)
+                std::sort(dataset, dataset + size, std::greater<T>());
+            else
+                std::sort(dataset, dataset + size, std::less<T>());
+        }
+
+        if constexpr (dataT == DT::NEARLY_SORTED)
+        {
+            Philox4x32 RNG(parallel.seed, STREAM_SWAPS);
+            perturbData(dataset, size, RNG);
+        }
+    }
+}
+
+//Elements [first, first + count) of a seeded stream of distribution values: every 'SHAPED_CHUNK' elements have their own sub-stream, since samplers
+//use a varying number of draws
+template <typename T>
+void dataset_detail::fillShaped(T* dataset, const std::uint64_t first, const size_t count, const T min, const T max, const Distribution& distribution, const std::uint64_t seed)
+{
+    const std::uint64_t last = first + count;
+
+    for(std::uint64_t chunk = first / SHAPED_CHUNK; chunk * SHAPED_CHUNK < last; chunk++)
+    {
+        StreamEngine RNG(seed, subStream(STREAM_SHAPED, chunk));
+
+        //A chunk cut by 'first' still has to make (and drop) the elements before it
+        const std::uint64_t begin = chunk * SHAPED_CHUNK, end = std::min(begin + SHAPED_CHUNK, last);
+        for(std::uint64_t i = begin; i < first; i++)
+            shapedValue(distribution, min, max, RNG);
+
+        for(std::uint64_t i = std::max(begin, first); i < end; i++)
+            dataset[i - first] = shapedValue(distribution, min, max, RNG);
+    }
+}
+
+//Validate a range
+template <typename T>
+constexpr void dataset_detail::checkRange(const T min, const T max)
+{
+    if (max < min)
+        throw std::invalid_argument("invalid range; maximum cannnot be less than the minimum.");
+
+    //Floating point: no NaNs, and the width has to be a finite number (written without 'std::isfinite()', which isn't 'constexpr')
+    if constexpr (isReal<T>)
+    {
+        if (not (min <= max) or not (max - min <= std::numeric_limits<T>::max()))
+            throw std::invalid_argument("invalid range; the minimum and maximum must be finite and their difference representable.");
+    }
+}
+
+//One uniform value
+template <typename T, typename Engine>
+T dataset_detail::drawValue(const T min, const T max, Engine& RNG)
+{
+    if constexpr (isReal<T>)
+        return min + static_cast<T>(unitDouble(draw64(RNG))) * (max - min);
+    else if constexpr (isWide<T>::value)
+    {
+        using U = typename unsignedOf<T>::type;
+        const U draw = static_cast<U>(draw64(RNG)) << 64 | draw64(RNG);
+        return static_cast<T>(static_cast<U>(static_cast<U>(min) + scaleWide(draw, static_cast<U>(static_cast<U>(max) - static_cast<U>(min)) + 1)));
+    }
+    else
+        return std::uniform_int_distribution<T>(min, max)(RNG);
+}
+
+//Multiply-shift for 128-bit draws: the high 128 bits of draw * range, from four 64x64 products
+template <typename U>
+constexpr U dataset_detail::scaleWide(const U draw, const U range) noexcept
+{
+    if (range == 0)
+        return draw;     //The range covers every 128-bit value
+
+    const std::uint64_t drawLow = static_cast<std::uint64_t>(draw), drawHigh = static_cast<std::uint64_t>(draw >> 64);
+    const std::uint64_t rangeLow = static_cast<std::uint64_t>(range), rangeHigh = static_cast<std::uint64_t>(range >> 64);
+
+    const U lowLow = static_cast<U>(drawLow) * rangeLow;
+    const U lowHigh = static_cast<U>(drawLow) * rangeHigh;
+    const U highLow = static_cast<U>(drawHigh) * rangeLow;
+    const U highHigh = static_cast<U>(drawHigh) * rangeHigh;
+
+    const U middle = (lowLow >> 64) + static_cast<std::uint64_t>(lowHigh) + static_cast<std::uint64_t>(highLow);
+    return highHigh + (lowHigh >> 64) + (highLow >> 64) + (middle >> 64);
+}
+
+//[0, 1) through the mantissa: 52 random bits under the exponent of 1.0 give [1, 2)
+inline double dataset_detail::unitDouble(const std::uint64_t bits) noexcept
+{
+    const std::uint64_t pattern = bits >> 12 | 0x3FF0000000000000;
+    double value;
+    std::memcpy(&value, &pattern, sizeof(value));
+    return value - 1.0;
+}
+
+//[0, 1) through the mantissa (23 bits)
+inline float dataset_detail::unitFloat(const std::uint32_t bits) noexcept
+{
+    const std::uint32_t pattern = bits >> 9 | 0x3F800000;
+    float value;
+    std::memcpy(&value, &pattern, sizeof(value));
+    return value - 1.0f;
+}
+
+//Key range
+template <typename T>
+dataset_detail::KeyMap<T>::KeyMap(const T min, const T max) noexcept: min(min), width(max - min) {}
+
+//Every value has a key
+template <typename T>
+bool dataset_detail::KeyMap<T>::enumerable() const noexcept
+{
+    if constexpr (isWide<T>::value)
+        return static_cast<typename unsignedOf<T>::type>(width) >> 64 == 0;
+    else
+        return true;
+}
+
+//Smallest key
+template <typename T>
+typename dataset_detail::KeyMap<T>::Key dataset_detail::KeyMap<T>::lowest() const noexcept
+{
+    if constexpr (direct)
+        return min;
+    else
+        return 0;
+}
+
+//Largest key
+template <typename T>
+typename dataset_detail::KeyMap<T>::Key dataset_detail::KeyMap<T>::highest() const noexcept
+{
+    if constexpr (direct)
+        return static_cast<T>(min + width);
+    else if constexpr (isReal<T>)
+        return (std::uint64_t(1) << 52) - 1;
+    else
+        return static_cast<std::uint64_t>(static_cast<typename unsignedOf<T>::type>(width));
+}
+
+//The value of a key (monotonic: the rounding of each step never reorders)
+template <typename T>
+T dataset_detail::KeyMap<T>::operator()(const Key key) const noexcept
+{
+    if constexpr (direct)
+        return key;
+    else if constexpr (isReal<T>)
+        return min + static_cast<T>(static_cast<double>(key) * 0x1p-52) * width;
+    else
+        return static_cast<T>(static_cast<typename unsignedOf<T>::type>(min) + key);
+}
+
+//Empty plan
+template <typename T>
+dataset_detail::SortedPlan<T>::SortedPlan() noexcept: min(0), range(0), elements(0), count(0), shift(0), counting(false) {}
+
+//Plan of a size + range
+template <typename T>
+dataset_detail::SortedPlan<T>::SortedPlan(const size_t size, const T min, const T max)
+{
+    reset(size, min, max);
+}
+
+//Choose the buckets (again)
+template <typename T>
+void dataset_detail::SortedPlan<T>::reset(const size_t size, const T min, const T max)
+{
+    using U = typename std::make_unsigned<T>::type;
+    this->min = min;
+    elements = size;
+    count = 1;
+    shift = 0;
+    counting = false;
+    range = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+
+    if (range < size and range < SORTED_MAX_BUCKETS)
+    {
+        //Fewer values than elements (e.g., 1M elements in 0..1000): count how often each value occurs
+        counting = true;
+        count = static_cast<size_t>(range) + 1;
+    }
+    else
+    {
+        //Otherwise about 'SORTED_BUCKET' elements per bucket, which also keeps every bucket at least that many values wide
+        while (count < SORTED_MAX_BUCKETS and (size >> shift) > SORTED_BUCKET)
+        {
+            shift++;
+            count <<= 1;
+        }
+    }
+
+    offsets.assign(count + 1, 0);     //Only allocates when the plan grows
+    offsets[count] = size;
+}
+
+//Split the elements between the buckets
+template <typename T>
+template <typename Binomial>
+void dataset_detail::SortedPlan<T>::distribute(Binomial binomial)
+{
+    //Each node sends Binomial(its elements, left width / width) of its elements to the left half and the rest to the right half
+    split([&](const size_t node, const size_t elements, const std::uint64_t left, const std::uint64_t right)
+    {
+        return binomial(node, elements, static_cast<double>(left) / (static_cast<double>(left) + static_cast<double>(right)));
+    });
+}
+
+//Split distinct elements between the buckets
+template <typename T>
+template <typename Hypergeometric>
+void dataset_detail::SortedPlan<T>::choose(Hypergeometric hypergeometric)
+{
+    //Without replacement, each node's left half gets a hypergeometric share of its elements (never more than it has values)
+    split(hypergeometric);
+}
+
+//Fill the bucket sizes
+template <typename T>
+template <typename Split>
+void dataset_detail::SortedPlan<T>::split(Split split)
+{
+    //Depth-first over a binary tree of bucket ranges (node n has children 2n and 2n+1): 'split()' says how many of a node's elements go to its
+    //left half, and the rest go to its right half
+    //The stack never holds more than one node per level (plus one), and there are at most 2^20 buckets
+    struct Node { size_t id, first, last, elements; };
+    Node pending[64] = {{1, 0, count, elements}};
+    size_t depth = 1;
+
+    std::fill(offsets.begin(), offsets.end(), 0);
+
+    while (depth != 0)
+    {
+        const Node node = pending[--depth];
+
+        if (node.last - node.first == 1)
+        {
+            offsets[node.first + 1] = node.elements;
+            continue;
+        }
+
+        const size_t middle = node.first + (node.last - node.first) / 2;
+        const std::uint64_t left = start(middle) - start(node.first);
+        const std::uint64_t right = start(node.last) - start(middle);    //Neither half can be 2^64 values wide
+        const size_t toLeft = node.elements == 0 ? 0 : split(node.id, node.elements, left, right);
+
+        pending[depth++] = {2 * node.id + 1, middle, node.last, node.elements - toLeft};
+        pending[depth++] = {2 * node.id, node.first, middle, toLeft};
+    }
+
+    //Bucket sizes -> first position of every bucket
+    for(size_t b=0; b < count; b++)
+        offsets[b + 1] += offsets[b];
+}
+
+//Bucket b's smallest value, as an offset from the minimum: floor(b * (range + 1) / 2^shift)
+template <typename T>
+std::uint64_t dataset_detail::SortedPlan<T>::start(const size_t b) const noexcept
+{
+    if (counting)
+        return b;
+
+    //128-bit b * range + b, shifted (bucket 2^shift starts at range + 1, which wraps to 0 for a full 64-bit range: widths still come out right)
+    std::uint64_t high;
+    std::uint64_t low = multiply64(b, range, high);
+    low += b;
+    high += low < b;
+
+    return shift == 0 ? low : (high << (64 - shift)) | (low >> shift);
+}
+
+//Number of buckets
+template <typename T>
+size_t dataset_detail::SortedPlan<T>::buckets() const noexcept
+{
+    return count;
+}
+
+//Dataset size
+template <typename T>
+size_t dataset_detail::SortedPlan<T>::size() const noexcept
+{
+    return elements;
+}
+
+//Ascending position of bucket b's first element
+template <typename T>
+size_t dataset_detail::SortedPlan<T>::offset(const size_t b) const noexcept
+{
+    return offsets[b];
+}
+
+//Bucket holding ascending position i (empty buckets never hold anything)
+template <typename T>
+size_t dataset_detail::SortedPlan<T>::find(const size_t i) const noexcept
+{
+    return static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), i) - offsets.begin()) - 1;
+}
+
+//Bucket b's smallest value
+template <typename T>
+T dataset_detail::SortedPlan<T>::lowest(const size_t b) const noexcept
+{
+    using U = typename std::make_unsigned<T>::type;
+    return static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(start(b))));
+}
+
+//Number of values in bucket b (0 = all 2^64)
+template <typename T>
+std::uint64_t dataset_detail::SortedPlan<T>::width(const size_t b) const noexcept
+{
+    return start(b + 1) - start(b);
+}
+
+//The bucket sizes for a seed
+template <typename T>
+void dataset_detail::seededPlan(SortedPlan<T>& plan, const size_t size, const T min, const T max, const std::uint64_t seed)
+{
+    plan.reset(size, min, max);
+    plan.distribute([&](const size_t node, const size_t elements, const double p)
+    {
+        Philox4x32 RNG(seed, subStream(STREAM_COUNTS, node));
+        return std::binomial_distribution<size_t>(elements, p)(RNG);
+    });
+}
+
+//The chosen values per bucket for a seed
+template <typename T>
+void dataset_detail::seededChoice(SortedPlan<T>& plan, const size_t size, const T min, const T max, const std::uint64_t seed)
+{
+    plan.reset(size, min, max);
+    plan.choose([&](const size_t node, const size_t elements, const std::uint64_t left, const std::uint64_t right)
+    {
+        Philox4x32 RNG(seed, subStream(STREAM_CHOICES, node));
+        return hypergeometric(left, right, elements, unitDouble(draw64(RNG)));
+    });
+}
+
+//Generate the bucket's sub-stream
+inline dataset_detail::BucketDraws::BucketDraws(const std::uint64_t seed, const size_t bucket, const size_t draws)
+{
+    thread_local std::vector<std::uint32_t> words;
+    words.resize(2 * draws);
+
+    fillStream<std::uint32_t>(words.data(), 0, words.size(), 0, std::numeric_limits<std::uint32_t>::max(), seed, subStream(STREAM_BUCKETS, bucket));
+    next = words.data();
+}
+
+//Next 64-bit draw
+inline std::uint64_t dataset_detail::BucketDraws::operator()() noexcept
+{
+    next += 2;
+    return static_cast<std::uint64_t>(next[-1]) << 32 | next[-2];
+}
+
+//Fill with elements [first, first + count) of a seeded stream
+template <typename T>
+void dataset_detail::fillStream(T* dataset, const std::uint64_t first, const size_t count, const T min, const T max, const std::uint64_t seed, const std::uint64_t stream)
+{
+    if constexpr (isReal<T>)
+    {
+        //Floating point: the stream's 32-bit words (one per draw, from the bulk kernel) through the mantissa trick; a float takes one word, wider types two
+        constexpr size_t WORDS = std::is_same<T, float>::value ? 1 : 2;
+        const T width = max - min;
+        std::uint32_t staging[2 * KERNEL_CHUNK];
+
+        for(size_t done=0; done < count; done += 2 * KERNEL_CHUNK / WORDS)
+        {
+            const size_t amount = std::min(2 * KERNEL_CHUNK / WORDS, count - done);
+            fillStream<std::uint32_t>(staging, (first + done) * WORDS, amount * WORDS, 0, std::numeric_limits<std::uint32_t>::max(), seed, stream);
+
+            T* out = dataset + done;
+            if constexpr (WORDS == 1)
+            {
+                for(size_t k=0; k < amount; k++)
+                    out[k] = min + unitFloat(staging[k]) * width;
+            }
+            else
+            {
+                for(size_t k=0; k < amount; k++)
+                    out[k] = min + static_cast<T>(unitDouble(static_cast<std::uint64_t>(staging[2*k + 1]) << 32 | staging[2*k])) * width;
+            }
+        }
+        return;
+    }
+    else if constexpr (isWide<T>::value)
+    {
+        //128-bit integers: four words per element, through the bulk kernel too
+        using U = typename unsignedOf<T>::type;
+        const U range = static_cast<U>(static_cast<U>(max) - static_cast<U>(min)) + 1;
+        std::uint32_t staging[2 * KERNEL_CHUNK];
+
+        for(size_t done=0; done < count; done += KERNEL_CHUNK / 2)
+        {
+            const size_t amount = std::min(KERNEL_CHUNK / 2, count - done);
+            fillStream<std::uint32_t>(staging, (first + done) * 4, amount * 4, 0, std::numeric_limits<std::uint32_t>::max(), seed, stream);
+
+            for(size_t k=0; k < amount; k++)
+            {
+                const std::uint32_t* words = staging + 4*k;
+                const U draw = static_cast<U>(static_cast<std::uint64_t>(words[3]) << 32 | words[2]) << 64 | (static_cast<std::uint64_t>(words[1]) << 32 | words[0]);
+                dataset[done + k] = static_cast<T>(static_cast<U>(static_cast<U>(min) + scaleWide(draw, range)));
+            }
+        }
+        return;
+    }
+    else
+        fillIntegers(dataset, first, count, min, max, seed, stream);
+}
+
+//Fill with elements [first, first + count) of a seeded stream (integers up to 64 bits)
+template <typename T>
+void dataset_detail::fillIntegers(T* dataset, const std::uint64_t first, const size_t count, const T min, const T max, const std::uint64_t seed, const std::uint64_t stream)
+{
+    //Work in unsigned arithmetic so negative minimums and full-width ranges wrap correctly
+    using U = typename std::make_unsigned<T>::type;
+    const std::uint64_t range = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(max) - static_cast<U>(min))) + 1;
+
+    //Bulk path: whole Philox blocks through the SIMD kernel (ranges up to 2^32, i.e. everything but wide 64-bit ranges)
+    if (range != 0 and range <= (std::uint64_t(1) << 32) and count >= KERNEL_MINIMUM)
+    {
+        const OffsetKernel kernel = offsetKernel();
+        const std::uint32_t base = static_cast<std::uint32_t>(static_cast<U>(min));     //Only the low 32 bits matter: offsets are < 2^32
+
+        //Odd first element: finish its block on the scalar path
+        const size_t head = first % 2;
+        fillStream(dataset, first, head, min, max, seed, stream);
+
+        const std::uint64_t firstBlock = (first + head) / 2;
+        const size_t blocks = (count - head) / 2;
+
+        if constexpr (std::is_same<U, std::uint32_t>::value)
+        {
+            //32-bit elements: the kernel writes straight into the array
+            kernel(reinterpret_cast<std::uint32_t*>(dataset + head), firstBlock, blocks, seed, stream, range, base);
+        }
+        else
+        {
+            //Other widths: kernel into an L1-resident staging buffer, then widen/narrow (a loop the compiler vectorizes)
+            std::uint32_t staging[2 * KERNEL_CHUNK];
+
+            for(size_t done=0; done < blocks; done += KERNEL_CHUNK)
+            {
+                const size_t amount = std::min(KERNEL_CHUNK, blocks - done);
+                kernel(staging, firstBlock + done, amount, seed, stream, range, 0);
+
+                T* out = dataset + head + 2 * done;
+                for(size_t k=0; k < 2 * amount; k++)
+                    out[k] = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(staging[k])));
+            }
+        }
+
+        //Odd element count: the last element is the first half of one more block
+        const size_t tail = head + 2 * blocks;
+        fillStream(dataset + tail, first + tail, count - tail, min, max, seed, stream);
+        return;
+    }
+
+    //Each Philox block holds two 64-bit draws: element i is half (i % 2) of block (i / 2)
+    std::uint64_t i = first;
+    size_t k = 0;
+
+    while (k < count)
+    {
+        const std::array<std::uint32_t, 4> words = Philox4x32::block(seed, i / 2, stream);
+
+        for(unsigned half = i % 2; half < 2 and k < count; half++, i++, k++)
+        {
+            const std::uint64_t draw = static_cast<std::uint64_t>(words[2*half + 1]) << 32 | words[2*half];
+            dataset[k] = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(scale(draw, range))));
+        }
+    }
+}
+
+/*
+    SIMD kernels: each vector lane runs the Philox rounds for one block, so a kernel produces exactly the same numbers as
+    'philoxOffsetsScalar()' (and the same numbers on every CPU), just several blocks at a time. The multiply-shift is done on
+    32-bit halves of the draw: high64(draw * range) = (high32 * range + (low32 * range >> 32)) >> 32 for range < 2^32
+*/
+
+//Portable kernel (also finishes the blocks left over by the SIMD kernels)
+inline void dataset_detail::philoxOffsetsScalar(std::uint32_t* out, const std::uint64_t first, const size_t blocks, const std::uint64_t seed, const std::uint64_t stream, const std::uint64_t range, const std::uint32_t base) noexcept
+{
+    for(size_t j=0; j < blocks; j++)
+    {
+        const std::array<std::uint32_t, 4> words = Philox4x32::block(seed, first + j, stream);
+
+        for(unsigned half=0; half < 2; half++)
+        {
+            const std::uint64_t draw = static_cast<std::uint64_t>(words[2*half + 1]) << 32 | words[2*half];
+            out[2*j + half] = base + static_cast<std::uint32_t>(scale(draw, range));
+        }
+    }
+}
+
+#if defined(DATASET_X86_SIMD)
+
+//AVX2 kernel: 4 blocks (8 elements) per vector, one block per 64-bit lane
+__attribute__((target("avx2")))
+inline void dataset_detail::philoxOffsetsAVX2(std::uint32_t* out, const std::uint64_t first, const size_t blocks, const std::uint64_t seed, const std::uint64_t stream, const std::uint64_t range, const std::uint32_t base) noexcept
+{
+    //Only the low 32 bits of each lane are meaningful; '_mm256_mul_epu32' ignores the high bits, so they are never masked
+    const __m256i multiplier0 = _mm256_set1_epi64x(0xD2511F53), multiplier1 = _mm256_set1_epi64x(0xCD9E8D57);
+    const __m256i streamLow = _mm256_set1_epi64x(static_cast<std::uint32_t>(stream)), streamHigh = _mm256_set1_epi64x(stream >> 32);
+    const __m256i lanes = _mm256_set_epi64x(3, 2, 1, 0);
+    const __m256i scaleBy = _mm256_set1_epi64x(static_cast<long long>(range));
+    const __m256i offset = _mm256_set1_epi32(static_cast<int>(base));
+    const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+    const bool fullRange = range == (std::uint64_t(1) << 32);
+
+    //The 10 round keys are the same for every block
+    __m256i key0[10], key1[10];
+    for(int round=0; round < 10; round++)
+    {
+        key0[round] = _mm256_set1_epi64x(static_cast<std::uint32_t>(static_cast<std::uint32_t>(seed) + round * 0x9E3779B9u));
+        key1[round] = _mm256_set1_epi64x(static_cast<std::uint32_t>(static_cast<std::uint32_t>(seed >> 32) + round * 0xBB67AE85u));
+    }
+
+    //The rounds are one long dependency chain, so 'UNROLL' independent vectors are interleaved to hide the multiply latency
+    //(the loops are fully unrolled so the vectors stay in registers, even at -O2)
+    constexpr size_t UNROLL = 2;
+
+    size_t j = 0;
+    for(; j + 4*UNROLL <= blocks; j += 4*UNROLL)
+    {
+        __m256i c0[UNROLL], c1[UNROLL], c2[UNROLL], c3[UNROLL];
+
+        #pragma GCC unroll 4
+
+        for(size_t u=0; u < UNROLL; u++)
+        {
+            const __m256i counter = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(first + j + 4*u)), lanes);
+            c0[u] = counter;
+            c1[u] = _mm256_srli_epi64(counter, 32);
+            c2[u] = streamLow;
+            c3[u] = streamHigh;
+        }
+
+        #pragma GCC unroll 10
+
+        for(int round=0; round < 10; round++)
+        {
+            #pragma GCC unroll 4
+            for(size_t u=0; u < UNROLL; u++)
+            {
+                const __m256i product0 = _mm256_mul_epu32(c0[u], multiplier0);
+                const __m256i product1 = _mm256_mul_epu32(c2[u], multiplier1);
+
+                c0[u] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(product1, 32), c1[u]), key0[round]);
+                c1[u] = product1;
+                c2[u] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(product0, 32), c3[u]), key1[round]);
+                c3[u] = product0;
+            }
+        }
+
+        #pragma GCC unroll 4
+
+        for(size_t u=0; u < UNROLL; u++)
+        {
+            //Draw 0 = (c1:c0) -> even elements, draw 1 = (c3:c2) -> odd elements
+            __m256i even, odd;
+            if (fullRange)
+            {
+                even = _mm256_and_si256(c1[u], lowMask);
+                odd = c3[u];
+            }
+            else
+            {
+                even = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epu32(c1[u], scaleBy), _mm256_srli_epi64(_mm256_mul_epu32(c0[u], scaleBy), 32)), 32);
+                odd = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epu32(c3[u], scaleBy), _mm256_srli_epi64(_mm256_mul_epu32(c2[u], scaleBy), 32)), 32);
+            }
+
+            //(odd << 32 | even) per lane is exactly the element order in memory
+            const __m256i result = _mm256_add_epi32(_mm256_or_si256(even, _mm256_slli_epi64(odd, 32)), offset);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2*(j + 4*u)), result);
+        }
+    }
+
+    philoxOffsetsScalar(out + 2*j, first + j, blocks - j, seed, stream, range, base);
+}
+
+//AVX-512 kernel: 8 blocks (16 elements) per vector, one block per 64-bit lane
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"     //GCC 12 warns about its own '_mm512_undefined_epi32()' inside the intrinsics
+__attribute__((target("avx512f")))
+inline void dataset_detail::philoxOffsetsAVX512(std::uint32_t* out, const std::uint64_t first, const size_t blocks, const std::uint64_t seed, const std::uint64_t stream, const std::uint64_t range, const std::uint32_t base) noexcept
+{
+    //Same lane layout as the AVX2 kernel
+    const __m512i multiplier0 = _mm512_set1_epi64(0xD2511F53), multiplier1 = _mm512_set1_epi64(0xCD9E8D57);
+    const __m512i streamLow = _mm512_set1_epi64(static_cast<std::uint32_t>(stream)), streamHigh = _mm512_set1_epi64(stream >> 32);
+    const __m512i lanes = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i scaleBy = _mm512_set1_epi64(static_cast<long long>(range));
+    const __m512i offset = _mm512_set1_epi32(static_cast<int>(base));
+    const __m512i lowMask = _mm512_set1_epi64(0xFFFFFFFF);
+    const bool fullRange = range == (std::uint64_t(1) << 32);
+
+    __m512i key0[10], key1[10];
+    for(int round=0; round < 10; round++)
+    {
+        key0[round] = _mm512_set1_epi64(static_cast<std::uint32_t>(static_cast<std::uint32_t>(seed) + round * 0x9E3779B9u));
+        key1[round] = _mm512_set1_epi64(static_cast<std::uint32_t>(static_cast<std::uint32_t>(seed >> 32) + round * 0xBB67AE85u));
+    }
+
+    //32 registers: room for 4 interleaved vectors
+    constexpr size_t UNROLL = 4;
+
+    size_t j = 0;
+    for(; j + 8*UNROLL <= blocks; j += 8*UNROLL)
+    {
+        __m512i c0[UNROLL], c1[UNROLL], c2[UNROLL], c3[UNROLL];
+
+        #pragma GCC unroll 4
+
+        for(size_t u=0; u < UNROLL; u++)
+        {
+            const __m512i counter = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(first + j + 8*u)), lanes);
+            c0[u] = counter;
+            c1[u] = _mm512_srli_epi64(counter, 32);
+            c2[u] = streamLow;
+            c3[u] = streamHigh;
+        }
+
+        #pragma GCC unroll 10
+
+        for(int round=0; round < 10; round++)
+        {
+            #pragma GCC unroll 4
+            for(size_t u=0; u < UNROLL; u++)
+            {
+                const __m512i product0 = _mm512_mul_epu32(c0[u], multiplier0);
+                const __m512i product1 = _mm512_mul_epu32(c2[u], multiplier1);
+
+                c0[u] = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(product1, 32), c1[u]), key0[round]);
+                c1[u] = product1;
+                c2[u] = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(product0, 32), c3[u]), key1[round]);
+                c3[u] = product0;
+            }
+        }
+
+        #pragma GCC unroll 4
+
+        for(size_t u=0; u < UNROLL; u++)
+        {
+            __m512i even, odd;
+            if (fullRange)
+            {
+                even = _mm512_and_si512(c1[u], lowMask);
+                odd = c3[u];
+            }
+            else
+            {
+                even = _mm512_srli_epi64(_mm512_add_epi64(_mm512_mul_epu32(c1[u], scaleBy), _mm512_srli_epi64(_mm512_mul_epu32(c0[u], scaleBy), 32)), 32);
+                odd = _mm512_srli_epi64(_mm512_add_epi64(_mm512_mul_epu32(c3[u], scaleBy), _mm512_srli_epi64(_mm512_mul_epu32(c2[u], scaleBy), 32)), 32);
+            }
+
+            const __m512i result = _mm512_add_epi32(_mm512_or_si512(even, _mm512_slli_epi64(odd, 32)), offset);
+            _mm512_storeu_si512(out + 2*(j + 8*u), result);
+        }
+    }
+
+    philoxOffsetsScalar(out + 2*j, first + j, blocks - j, seed, stream, range, base);
+}
+#pragma GCC diagnostic pop
+
+#elif defined(DATASET_NEON_SIMD)
+
+//NEON kernel: 2 blocks (4 elements) per iteration, one block per 32-bit lane of each word
+inline void dataset_detail::philoxOffsetsNEON(std::uint32_t* out, const std::uint64_t first, const size_t blocks, const std::uint64_t seed, const std::uint64_t stream, const std::uint64_t range, const std::uint32_t base) noexcept
+{
+    const uint32x2_t multiplier0 = vdup_n_u32(0xD2511F53u), multiplier1 = vdup_n_u32(0xCD9E8D57u);
+    const uint32x2_t streamLow = vdup_n_u32(static_cast<std::uint32_t>(stream)), streamHigh = vdup_n_u32(static_cast<std::uint32_t>(stream >> 32));
+    const uint64x2_t lanes = vcombine_u64(vcreate_u64(0), vcreate_u64(1));
+    const uint32x2_t scaleBy = vdup_n_u32(static_cast<std::uint32_t>(range));
+    const uint32x4_t offset = vdupq_n_u32(base);
+    const bool fullRange = range == (std::uint64_t(1) << 32);
+
+    size_t j = 0;
+    for(; j + 2 <= blocks; j += 2)
+    {
+        const uint64x2_t counter = vaddq_u64(vdupq_n_u64(first + j), lanes);
+        uint32x2_t c0 = vmovn_u64(counter), c1 = vshrn_n_u64(counter, 32), c2 = streamLow, c3 = streamHigh;
+        std::uint32_t k0 = static_cast<std::uint32_t>(seed), k1 = static_cast<std::uint32_t>(seed >> 32);
+
+        for(int round=0; round < 10; round++)
+        {
+            const uint64x2_t product0 = vmull_u32(c0, multiplier0);
+            const uint64x2_t product1 = vmull_u32(c2, multiplier1);
+
+            c0 = veor_u32(veor_u32(vshrn_n_u64(product1, 32), c1), vdup_n_u32(k0));
+            c1 = vmovn_u64(product1);
+            c2 = veor_u32(veor_u32(vshrn_n_u64(product0, 32), c3), vdup_n_u32(k1));
+            c3 = vmovn_u64(product0);
+
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+
+        uint32x2_t even, odd;
+        if (fullRange)
+        {
+            even = c1;
+            odd = c3;
+        }
+        else
+        {
+            even = vshrn_n_u64(vaddq_u64(vmull_u32(c1, scaleBy), vshrq_n_u64(vmull_u32(c0, scaleBy), 32)), 32);
+            odd = vshrn_n_u64(vaddq_u64(vmull_u32(c3, scaleBy), vshrq_n_u64(vmull_u32(c2, scaleBy), 32)), 32);
+        }
+
+        //Interleave to element order: even0, odd0, even1, odd1
+        const uint32x2x2_t zipped = vzip_u32(even, odd);
+        vst1q_u32(out + 2*j, vaddq_u32(vcombine_u32(zipped.val[0], zipped.val[1]), offset));
+    }
+
+    philoxOffsetsScalar(out + 2*j, first + j, blocks - j, seed, stream, range, base);
+}
+
+#endif
+
+//Pick the fastest kernel
+inline dataset_detail::OffsetKernel dataset_detail::offsetKernel() noexcept
+{
+    //Runtime dispatch: one binary runs on every x86-64 CPU and uses the widest vectors it has
+    static const OffsetKernel kernel = []() noexcept -> OffsetKernel
+    {
+#if defined(DATASET_X86_SIMD)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f"))
+            return philoxOffsetsAVX512;
+        if (__builtin_cpu_supports("avx2"))
+            return philoxOffsetsAVX2;
+#elif defined(DATASET_NEON_SIMD)
+        return philoxOffsetsNEON;
+#endif
+        return philoxOffsetsScalar;
+    }();
+
+    return kernel;
+}
+
+//Six Philox2x32 rounds on (high, low) with round keys from the golden ratio: each round is invertible (odd multiplier), so the whole mix is a bijection
+constexpr std::uint64_t dataset_detail::mixValue(const std::uint64_t value) noexcept
+{
+    std::uint32_t left = static_cast<std::uint32_t>(value >> 32), right = static_cast<std::uint32_t>(value);
+
+    for(std::uint32_t round=0; round < 6; round++)
+    {
+        const std::uint64_t product = static_cast<std::uint64_t>(right) * 0xD2511F53u;
+        right = static_cast<std::uint32_t>(product >> 32) ^ left ^ ((round + 1) * 0x9E3779B9u);
+        left = static_cast<std::uint32_t>(product);
+    }
+
+    return static_cast<std::uint64_t>(left) << 32 | right;
+}
+
+//Portable kernel (also finishes the words left over by the SIMD kernel)
+inline std::uint64_t dataset_detail::hashSumScalar(const void* words, const size_t count, const unsigned width) noexcept
+{
+    std::uint64_t sum = 0;
+
+    for(size_t i=0; i < count; i++)
+    {
+        if (width == 4)
+            sum += mixValue(static_cast<const std::uint32_t*>(words)[i]);
+        else
+            sum += mixValue(static_cast<const std::uint64_t*>(words)[i]);
+    }
+
+    return sum;
+}
+
+#if defined(DATASET_X86_SIMD)
+
+//AVX2 kernel: 4 words per vector, one word per 64-bit lane (32-bit words zero-extended), four vectors interleaved to hide the multiply latency
+__attribute__((target("avx2")))
+inline std::uint64_t dataset_detail::hashSumAVX2(const void* words, const size_t count, const unsigned width) noexcept
+{
+    //Only the low 32 bits of each lane are meaningful until the end; '_mm256_mul_epu32' ignores the high bits, so they are never masked
+    const __m256i multiplier = _mm256_set1_epi64x(0xD2511F53), lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+    constexpr size_t UNROLL = 4;
+
+    //The 6 round keys are the same for every word
+    __m256i keys[6];
+    for(std::uint32_t round=0; round < 6; round++)
+        keys[round] = _mm256_set1_epi64x((round + 1) * 0x9E3779B9u);
+
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for(; i + 4*UNROLL <= count; i += 4*UNROLL)
+    {
+        __m256i left[UNROLL], right[UNROLL];
+
+        #pragma GCC unroll 4
+
+        for(size_t u=0; u < UNROLL; u++)
+        {
+            if (width == 4)
+                right[u] = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(static_cast<const std::uint32_t*>(words) + i + 4*u)));
+            else
+                right[u] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(static_cast<const std::uint64_t*>(words) + i + 4*u));
+            left[u] = _mm256_srli_epi64(right[u], 32);
+        }
+
+        #pragma GCC unroll 6
+
+        for(int round=0; round < 6; round++)
+        {
+            #pragma GCC unroll 4
+            for(size_t u=0; u < UNROLL; u++)
+            {
+                const __m256i product = _mm256_mul_epu32(right[u], multiplier);
+                right[u] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(product, 32), left[u]), keys[round]);
+                left[u] = product;
+            }
+        }
+
+        #pragma GCC unroll 4
+
+        for(size_t u=0; u < UNROLL; u++)
+            sum = _mm256_add_epi64(sum, _mm256_or_si256(_mm256_slli_epi64(left[u], 32), _mm256_and_si256(right[u], lowMask)));
+    }
+
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+
+    const void* rest = width == 4 ? static_cast<const void*>(static_cast<const std::uint32_t*>(words) + i) : static_cast<const void*>(static_cast<const std::uint64_t*>(words) + i);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + hashSumScalar(rest, count - i, width);
+}
+
+#endif
+
+//Pick the fastest kernel
+inline dataset_detail::HashSumKernel dataset_detail::hashSumKernel() noexcept
+{
+    static const HashSumKernel kernel = []() noexcept -> HashSumKernel
+    {
+#if defined(DATASET_X86_SIMD)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return hashSumAVX2;
+#endif
+        return hashSumScalar;
+    }();
+
+    return kernel;
+}
+
+//Multiply-shift range reduction (Lemire, "Fast random integer generation in an interval")
+constexpr std::uint64_t dataset_detail::scale(const std::uint64_t draw, const std::uint64_t range) noexcept
+{
+    if (range == 0)
+        return draw;     //The range covers every 64-bit value
+
+    std::uint64_t high = 0;
+    multiply64(draw, range, high);
+    return high;
+}
+
+//Full 64x64 -> 128 bit product
+constexpr std::uint64_t dataset_detail::multiply64(const std::uint64_t a, const std::uint64_t b, std::uint64_t& high) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<std::uint64_t>(product >> 64);
+    return static_cast<std::uint64_t>(product);
+#else
+    //Four 32x32 -> 64 bit products
+    const std::uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+    const std::uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+    const std::uint64_t middle = (aLow * bLow >> 32) + (aHigh * bLow & 0xFFFFFFFFu) + aLow * bHigh;
+    high = aHigh * bHigh + (aHigh * bLow >> 32) + (middle >> 32);
+    return a * b;
+#endif
+}
+
+//Rotate left
+constexpr std::uint64_t dataset_detail::rotl(const std::uint64_t x, const int k) noexcept
+{
+    return (x << (k & 63)) | (x >> (-k & 63));
+}
+
+//Rotate right
+constexpr std::uint64_t dataset_detail::rotr(const std::uint64_t x, const int k) noexcept
+{
+    return (x >> (k & 63)) | (x << (-k & 63));
+}
+
+//This thread's engine for unseeded generation
+template <typename Engine>
+Engine& dataset_detail::threadEngine()
+{
+    //'std::random_device' may be a syscall and a Mersenne Twister has 2.5KB of state: pay for both once per thread, not once per dataset
+    thread_local Engine RNG = []()
+    {
+        std::random_device rd;
+
+        //Standard engines take a seed sequence, the built-in ones a 64-bit seed
+        if constexpr (std::is_constructible<Engine, std::seed_seq&>::value)
+        {
+            std::seed_seq sequence{rd(), rd(), rd(), rd(), rd(), rd(), rd(), rd()};
+            return Engine(sequence);
+        }
+        else
+            return Engine(static_cast<std::uint64_t>(rd()) << 32 | rd());
+    }();
+
+    return RNG;
+}
+
+//The seed sequence of a 64-bit seed: fills exactly what 'std::seed_seq{low 32 bits, high 32 bits}' would, but keeps its two words inline
+//('std::seed_seq' copies them into a vector, which made every seeded regeneration allocate)
+class dataset_detail::SeedSequence
+{
+    // DATA MEMBERS //
+    private:
+        std::uint32_t words[2];     //Low, high half of the seed
+
+    // FUNCTION MEMBERS //
+    public:
+        using result_type = std::uint32_t;
+
+        //Public special methods
+        explicit SeedSequence(const std::uint64_t) noexcept;    //seed
+
+        //Public methods
+        template <typename Iterator>
+        void generate(Iterator, Iterator) const;              //The standard's 'seed_seq::generate()' algorithm
+        static constexpr size_t size() noexcept { return 2; }
+};
+
+//Split the seed
+inline dataset_detail::SeedSequence::SeedSequence(const std::uint64_t seed) noexcept: words{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {}
+
+//Fill [first, last) with 32-bit words
+template <typename Iterator>
+void dataset_detail::SeedSequence::generate(Iterator first, Iterator last) const
+{
+    const size_t n = static_cast<size_t>(last - first);
+    if (n == 0)
+        return;
+
+    const size_t s = size();
+    const size_t t = n >= 623 ? 11 : n >= 68 ? 7 : n >= 39 ? 5 : n >= 7 ? 3 : (n - 1) / 2;
+    const size_t p = (n - t) / 2, q = p + t, m = std::max(s + 1, n);
+    const auto mix = [](const std::uint32_t x) { return x ^ (x >> 27); };
+    const auto at = [&](const size_t k) -> auto& { return first[k % n]; };    //Wraps around
+
+    for(Iterator it=first; it != last; ++it)
+        *it = 0x8b8b8b8bu;
+
+    //Words are 32 bits, whatever type the engine's iterator holds
+    for(size_t k=0; k < m; k++)
+    {
+        const std::uint32_t r1 = static_cast<std::uint32_t>(1664525u * mix(static_cast<std::uint32_t>(at(k) ^ at(k + p) ^ at(k + n - 1))));
+        const std::uint32_t r2 = static_cast<std::uint32_t>(r1 + (k == 0 ? s : k <= s ? k % n + words[k - 1] : k % n));
+        at(k + p) = static_cast<std::uint32_t>(at(k + p) + r1);
+        at(k + q) = static_cast<std::uint32_t>(at(k + q) + r2);
+        at(k) = r2;
+    }
+
+    for(size_t k=m; k < m + n; k++)
+    {
+        const std::uint32_t r3 = static_cast<std::uint32_t>(1566083941u * mix(static_cast<std::uint32_t>(at(k) + at(k + p) + at(k + n - 1))));
+        const std::uint32_t r4 = static_cast<std::uint32_t>(r3 - k % n);
+        at(k + p) = static_cast<std::uint32_t>(at(k + p) ^ r3);
+        at(k + q) = static_cast<std::uint32_t>(at(k + q) ^ r4);
+        at(k) = r4;
+    }
+}
+
+//An engine seeded from 64 bits
+template <typename Engine>
+Engine dataset_detail::seededEngine(const std::uint64_t seed)
+{
+    //Both halves of the seed go through the seed sequence, so seeds that differ only in the top bits still give different data
+    if constexpr (std::is_constructible<Engine, std::seed_seq&>::value)
+    {
+        SeedSequence sequence(seed);
+        return Engine(sequence);
+    }
+    else
+        return Engine(seed);
+}
+
+//64 random bits from any engine
+template <typename Engine>
+std::uint64_t dataset_detail::draw64(Engine& RNG)
+{
+    //Full-width 64-bit and 32-bit engines are used as-is; anything else goes through the standard distribution
+    if constexpr (Engine::min() == 0 and Engine::max() == std::numeric_limits<std::uint64_t>::max())
+        return RNG();
+    else if constexpr (Engine::min() == 0 and Engine::max() == std::numeric_limits<std::uint32_t>::max())
+    {
+        const std::uint64_t low = RNG();
+        return static_cast<std::uint64_t>(RNG()) << 32 | low;
+    }
+    else
+        return std::uniform_int_distribution<std::uint64_t>()(RNG);
+}
+
+//Sub-stream 'index' of a stream
+constexpr std::uint64_t dataset_detail::subStream(const std::uint64_t stream, const std::uint64_t index) noexcept
+{
+    return stream | index << 8;
+}
+
+//The seed of run r
+inline std::uint64_t dataset_detail::runSeed(const std::uint64_t seed, const std::uint64_t run) noexcept
+{
+    const std::array<std::uint32_t, 4> words = Philox4x32::block(seed, run, STREAM_RUNS);
+    return static_cast<std::uint64_t>(words[1]) << 32 | words[0];
+}
+
+//A fresh random seed
+inline std::uint64_t randomSeed()
+{
+    std::mt19937& RNG = dataset_detail::threadEngine<std::mt19937>();
+    const std::uint64_t high = RNG();
+    return high << 32 | RNG();
+}
+
+//The range of a shard
+inline std::pair<size_t, size_t> shardRange(const Shard& shard)
+{
+    if (shard.index >= shard.count)
+        throw std::invalid_argument("invalid shard; the index must be less than the shard count.");
+    if (shard.total < shard.count)
+        throw std::invalid_argument("invalid shard; every shard needs an element, so the total can't be less than the shard count.");
+
+    //(the same split as 'parallelFor()' makes between threads)
+    const auto start = [&](const size_t i) { return (shard.total / shard.count) * i + std::min(i, shard.total % shard.count); };
+    return {start(shard.index), start(shard.index + 1)};
+}
+
+//Run 'function(first, last)' over contiguous ranges of [0, size), one range per thread
+template <typename Function>
+void dataset_detail::parallelFor(const size_t size, const unsigned threads, Function function)
+{
+    //0 threads means every core; never give a thread less than 'PARALLEL_GRAIN' elements
+    size_t workers = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    workers = std::max<size_t>(1, std::min(workers, size / PARALLEL_GRAIN));
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+
+    //Range t is [start(t), start(t+1)); the first 'size % workers' ranges get one extra element
+    const auto start = [&](const size_t t) { return (size / workers) * t + std::min(t, size % workers); };
+
+    try
+    {
+        for(size_t t=0; t + 1 < workers; t++)
+            pool.emplace_back(function, start(t), start(t + 1));
+    }
+    catch (...)
+    {
+        //Couldn't start every thread: wait for the ones that did start before giving up
+        for(std::thread& worker : pool)
+            worker.join();
+        throw;
+    }
+
+    //The calling thread takes the last range
+    function(start(workers - 1), size);
+
+    for(std::thread& worker : pool)
+        worker.join();
+}
+
+//The default huge page size (read once)
+inline size_t dataset_detail::hugePageSize() noexcept
+{
+    static const size_t size = []() noexcept
+    {
+        size_t kilobytes = 2048;
+
+#if defined(__linux__)
+        if (std::FILE* meminfo = std::fopen("/proc/meminfo", "r"))
+        {
+            char line[128];
+            unsigned long long value;
+
+            while (std::fgets(line, sizeof(line), meminfo))
+                if (std::sscanf(line, "Hugepagesize: %llu kB", &value) == 1 and value > 0)
+                    kilobytes = value;
+
+            std::fclose(meminfo);
+        }
+#endif
+
+        return kilobytes * 1024;
+    }();
+
+    return size;
+}
+
+//Round up to whole huge pages (the kernel won't unmap part of one, so 'munmap()' needs this length too)
+inline size_t dataset_detail::hugeLength(const size_t bytes) noexcept
+{
+    const size_t page = hugePageSize();
+    return bytes > std::numeric_limits<size_t>::max() - (page - 1) ? 0 : (bytes + page - 1) / page * page;    //0: too big to map at all
+}
+
+//Allocate aligned storage
+inline void* dataset_detail::allocate(const size_t bytes, const Memory source)
+{
+#if defined(__linux__)
+    if (source == Memory::HUGE_PAGES)
+    {
+        //Both mappings are whole huge pages long, so 'deallocate()' unmaps the same length either way
+        const size_t length = hugeLength(bytes);
+        if (length == 0)
+            throw std::bad_alloc();
+
+        //Explicit huge pages first (needs pages reserved in /proc/sys/vm/nr_hugepages), then transparent huge pages
+        void* pages = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (pages == MAP_FAILED)
+        {
+            pages = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (pages == MAP_FAILED)
+                throw std::bad_alloc();
+
+            madvise(pages, length, MADV_HUGEPAGE);    //Only a hint; the kernel may ignore it
+        }
+
+        return pages;    //Page-aligned, so also 'DATASET_ALIGNMENT'-aligned
+    }
+
+    if (source == Memory::NUMA)
+    {
+        //Fresh pages: the heap may hand back memory another thread already touched (and so already placed)
+        void* pages = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pages == MAP_FAILED)
+            throw std::bad_alloc();
+
+        return pages;
+    }
+#endif
+
+    //Heap (and huge pages or NUMA placement on platforms without 'mmap()')
+    return ::operator new(bytes, std::align_val_t(DATASET_ALIGNMENT));
+}
+
+//Release aligned storage
+inline void dataset_detail::deallocate(void* memory, const size_t bytes, const Memory source) noexcept
+{
+#if defined(__linux__)
+    if (source == Memory::HUGE_PAGES or source == Memory::NUMA)
+    {
+        //Only a length other than the mapping's can fail here
+        [[maybe_unused]] const int unmapped = munmap(memory, source == Memory::HUGE_PAGES ? hugeLength(bytes) : bytes);
+        assert(unmapped == 0);
+        return;
+    }
+#endif
+
+#if defined(DATASET_POSIX_IO)
+    //Cached datasets: the mapping starts at the file's header
+    if (source == Memory::MAPPED)
+    {
+        munmap(static_cast<char*>(memory) - sizeof(CacheHeader), bytes + sizeof(CacheHeader));
+        return;
+    }
+#endif
+
+    (void)bytes;   //Only needed by 'munmap()'
+    ::operator delete(memory, std::align_val_t(DATASET_ALIGNMENT));
+}
+
+#if defined(DATASET_NUMA)
+//The nodes this process may use
+inline bool dataset_detail::allowedNodes(unsigned long (&mask)[NUMA_MAX_NODES / (8 * sizeof(unsigned long))]) noexcept
+{
+    std::memset(mask, 0, sizeof(mask));
+    return syscall(SYS_get_mempolicy, nullptr, mask, NUMA_MAX_NODES, nullptr, MPOL_F_MEMS_ALLOWED) == 0;
+}
+#endif
+
+//Place untouched pages
+inline void dataset_detail::place(void* memory, const size_t bytes, const Numa& numa)
+{
+#if defined(DATASET_NUMA)
+    constexpr size_t BITS = 8 * sizeof(unsigned long);
+    unsigned long allowed[NUMA_MAX_NODES / BITS];
+
+    if (numa.placement == Placement::BIND and (numa.node < 0 or static_cast<size_t>(numa.node) >= NUMA_MAX_NODES))
+        throw std::invalid_argument("invalid NUMA node; the node must be one of 'numaNodes()'.");
+
+    //No NUMA support: one node, so there is nothing to place
+    if (not allowedNodes(allowed))
+    {
+        if (numa.placement == Placement::BIND and numa.node != 0)
+            throw std::invalid_argument("invalid NUMA node; the node must be one of 'numaNodes()'.");
+        return;
+    }
+
+    int mode = MPOL_PREFERRED;      //An empty preferred set means "the node of the thread that touches the page"
+    unsigned long nodes[NUMA_MAX_NODES / BITS] = {};
+
+    if (numa.placement == Placement::INTERLEAVE)
+    {
+        mode = MPOL_INTERLEAVE;
+        std::memcpy(nodes, allowed, sizeof(nodes));
+    }
+    else if (numa.placement == Placement::BIND)
+    {
+        const size_t node = static_cast<size_t>(numa.node);
+        if (not (allowed[node / BITS] >> (node % BITS) & 1))
+            throw std::invalid_argument("invalid NUMA node; the node must be one of 'numaNodes()'.");
+
+        mode = MPOL_BIND;
+        nodes[node / BITS] = 1ul << (node % BITS);
+    }
+
+    //The kernel reads one bit less than 'maxnode'
+    if (syscall(SYS_mbind, memory, bytes, mode, nodes, NUMA_MAX_NODES + 1, 0) != 0 and numa.placement == Placement::BIND)
+        throw std::system_error(errno, std::generic_category(), "couldn't bind the dataset to its NUMA node");
+#else
+    (void)memory;
+    (void)bytes;
+    if (numa.placement == Placement::BIND and numa.node != 0)
+        throw std::invalid_argument("invalid NUMA node; the node must be one of 'numaNodes()'.");
+#endif
+}
+
+//Allowed NUMA nodes
+inline std::vector<int> numaNodes()
+{
+#if defined(DATASET_NUMA)
+    constexpr size_t BITS = 8 * sizeof(unsigned long);
+    unsigned long allowed[dataset_detail::NUMA_MAX_NODES / BITS];
+
+    if (dataset_detail::allowedNodes(allowed))
+    {
+        std::vector<int> nodes;
+        for(size_t node=0; node < dataset_detail::NUMA_MAX_NODES; node++)
+            if (allowed[node / BITS] >> (node % BITS) & 1)
+                nodes.push_back(static_cast<int>(node));
+
+        return nodes;
+    }
+#endif
+
+    return {0};
+}
+
+//Fast 64-bit hash: four independent multiply-rotate lanes over 8-byte words (several GB/s), folded together at the end
+inline std::uint64_t dataset_detail::checksum(const void* memory, const size_t bytes) noexcept
+{
+    constexpr std::uint64_t PRIME = 0x9E3779B97F4A7C15;
+    const unsigned char* data = static_cast<const unsigned char*>(memory);
+    std::uint64_t lane[4] = {1, 2, 3, 4};
+
+    size_t i = 0;
+    for(; i + 32 <= bytes; i += 32)
+    {
+        for(int l=0; l < 4; l++)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i + 8*l, 8);
+            lane[l] = rotl((lane[l] ^ word) * PRIME, 31);
+        }
+    }
+
+    //Leftover bytes, then the length (so trailing zeros still change the hash)
+    std::uint64_t hash = bytes;
+    for(; i < bytes; i++)
+        hash = (hash ^ data[i]) * PRIME;
+
+    for(int l=0; l < 4; l++)
+        hash = rotl((hash ^ lane[l]) * PRIME, 29);
+
+    return hash ^ (hash >> 32);
+}
+
+//FNV-1a
+inline std::uint64_t dataset_detail::hashName(const char* name) noexcept
+{
+    std::uint64_t hash = 0xCBF29CE484222325;
+    for(; *name != '\0'; name++)
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 0x100000001B3;
+
+    return hash;
+}
+
+#if defined(DATASET_POSIX_IO)
+
+//The header a dataset's cache file must have
+template <typename T, DT dataT>
+dataset_detail::CacheHeader dataset_detail::cacheHeader(const size_t size, const T min, const T max, const std::uint64_t seed, const char* engine)
+{
+    CacheHeader header{{'D', 'A', 'T', 'A', 'S', 'E', 'T', '\0'}, CACHE_VERSION,
+                       static_cast<std::uint32_t>(sizeof(T) | isSigned<T> << 8 | isReal<T> << 9 | static_cast<unsigned>(dataT) << 16),
+                       size, rangeBits(min), rangeBits(max), seed, hashName(engine), 0};
+    return header;
+}
+
+//A range bound as a header field
+template <typename T>
+std::uint64_t dataset_detail::rangeBits(const T value) noexcept
+{
+    if constexpr (isReal<T>)
+    {
+        //Bit pattern (so -0.0 and 0.0 name different files, like they generate different data)
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, std::min(sizeof(value), sizeof(bits)));
+        return bits;
+    }
+    else if constexpr (isWide<T>::value)
+    {
+        const auto bits = static_cast<typename unsignedOf<T>::type>(value);
+        return static_cast<std::uint64_t>(bits) ^ rotl(static_cast<std::uint64_t>(bits >> 64) * 0x9E3779B97F4A7C15, 32);
+    }
+    else
+        return static_cast<typename std::make_unsigned<T>::type>(value);
+}
+
+//<directory>/<hash of the header>.dataset
+inline std::string dataset_detail::cachePath(const Cache& cache, const CacheHeader& header)
+{
+    CacheHeader key = header;
+    key.checksum = 0;
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.dataset", static_cast<unsigned long long>(checksum(&key, sizeof(key))));
+    return cache.directory + "/" + name;
+}
+
+//Map a cached dataset
+inline void* dataset_detail::mapCached(const std::string& path, const CacheHeader& expected, const bool verify)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+
+    //The file must be complete and describe exactly this dataset
+    const size_t bytes = sizeof(CacheHeader) + expected.size * (expected.type & 0xFF);
+    CacheHeader header;
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 or static_cast<size_t>(info.st_size) != bytes or pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    header.checksum = expected.checksum;
+    if (std::memcmp(&header, &expected, sizeof(header)) != 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    //Private mapping: the dataset stays writable (e.g., 'genNewData()'), but writes never reach the file
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    char* data = static_cast<char*>(mapping) + sizeof(CacheHeader);
+
+    if (verify and checksum(data, bytes - sizeof(CacheHeader)) != static_cast<const CacheHeader*>(mapping)->checksum)
+    {
+        munmap(mapping, bytes);
+        return nullptr;
+    }
+
+    return data;
+}
+
+//Create a file to generate a dataset into
+inline void* dataset_detail::createCached(const std::string& path, const size_t bytes)
+{
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        throw std::system_error(errno, std::generic_category(), "cannot create cache file '" + path + "'");
+
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(sizeof(CacheHeader) + bytes)) == 0)
+        mapping = mmap(nullptr, sizeof(CacheHeader) + bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    const int error = errno;
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        unlink(path.c_str());
+        throw std::system_error(error, std::generic_category(), "cannot map cache file '" + path + "'");
+    }
+
+    return static_cast<char*>(mapping) + sizeof(CacheHeader);
+}
+
+//Finish a cache file
+inline void dataset_detail::publishCached(void* data, const size_t bytes, CacheHeader header, const std::string& temporary, const std::string& path)
+{
+    char* mapping = static_cast<char*>(data) - sizeof(CacheHeader);
+
+    //The header goes in last, so a half-written file never matches
+    header.checksum = checksum(data, bytes);
+    std::memcpy(mapping, &header, sizeof(header));
+    munmap(mapping, sizeof(CacheHeader) + bytes);
+
+    //Atomic: concurrent runs either see the whole file or none
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        const int error = errno;
+        unlink(temporary.c_str());
+        throw std::system_error(error, std::generic_category(), "cannot publish cache file '" + path + "'");
+    }
+}
+
+#endif
+
+
+/*
+    +----------------------------+
+    |   Output Implementation    |
+    +----------------------------+
+*/
+
+// ********** TEXT **********
+
+//Work out the separators
+template <typename T>
+dataset_detail::TextFormatter<T>::TextFormatter(const TextFormat& layout, const size_t count): separator(layout.separator), json(layout.framing == Framing::JSON),
+    lineWidth(layout.lineWidth), remaining(count), column(0)
+{
+    if (separator.empty())
+        separator = layout.framing == Framing::PLAIN ? " " : layout.framing == Framing::CSV ? "," : ", ";
+
+    //JSON keeps its commas at line ends
+    lineBreak = json ? ",\n" : "\n";
+    closing = json ? "]\n" : "\n";
+}
+
+//Widest value: sign + every digit, then the longest thing that can follow it
+template <typename T>
+size_t dataset_detail::TextFormatter<T>::widest() const noexcept
+{
+    return DIGITS + std::max({separator.size(), lineBreak.size(), closing.size()});
+}
+
+//One value
+template <typename T>
+char* dataset_detail::TextFormatter<T>::digits(char* text, const T value) noexcept
+{
+    if constexpr (isWide<T>::value)
+    {
+        using U = typename unsignedOf<T>::type;
+        constexpr std::uint64_t CHUNK = 10000000000000000000u;    //10^19, the most a 64-bit 'std::to_chars' prints at once
+
+        U magnitude = static_cast<U>(value);
+        if constexpr (isSigned<T>)
+        {
+            if (value < 0)
+            {
+                *text++ = '-';
+                magnitude = -magnitude;
+            }
+        }
+
+        //At most three chunks: the leading one as is, the others zero-padded to 19 digits
+        std::uint64_t chunks[3];
+        size_t used = 0;
+        do
+        {
+            chunks[used++] = static_cast<std::uint64_t>(magnitude % CHUNK);
+            magnitude /= CHUNK;
+        }
+        while (magnitude != 0);
+
+        text = std::to_chars(text, text + 20, chunks[--used]).ptr;
+        while (used != 0)
+        {
+            char padded[20];
+            char* end = std::to_chars(padded, padded + 20, chunks[--used]).ptr;
+            text = std::fill_n(text, 19 - (end - padded), '0');
+            text = std::copy(padded, end, text);
+        }
+        return text;
+    }
+    else
+        return std::to_chars(text, text + DIGITS, value).ptr;
+}
+
+//Opening framing
+template <typename T>
+char* dataset_detail::TextFormatter<T>::open(char* text) const noexcept
+{
+    if (json)
+        *text++ = '[';
+    return text;
+}
+
+//Format values
+template <typename T>
+char* dataset_detail::TextFormatter<T>::format(char* text, const T* values, const size_t count) noexcept
+{
+    const auto append = [&](const std::string& piece)
+    {
+        //Single characters (the usual separators) skip the copy
+        if (piece.size() == 1)
+            *text++ = piece[0];
+        else
+            text = std::copy(piece.begin(), piece.end(), text);
+    };
+
+    for(size_t k=0; k < count; k++)
+    {
+        text = digits(text, values[k]);
+
+        if (--remaining == 0)
+            append(closing);
+        else if (lineWidth != 0 and ++column == lineWidth)
+        {
+            column = 0;
+            append(lineBreak);
+        }
+        else
+            append(separator);
+    }
+
+    return text;
+}
+
+//Format 'length' elements to a stream, one chunk at a time
+template <typename T, typename Fill>
+void dataset_detail::printStream(std::ostream& out, const size_t length, const TextFormat& layout, Fill fill)
+{
+    TextFormatter<T> formatter(layout, length);
+    const size_t perChunk = std::max<size_t>(1, std::min(VIEW_CHUNK, length));
+
+    std::vector<T> values(perChunk);
+    std::vector<char> text(perChunk * formatter.widest() + 1);
+
+    for(size_t first=0; first < length; first += perChunk)
+    {
+        const size_t count = std::min(perChunk, length - first);
+        fill(values.data(), first, count);
+
+        char* end = first == 0 ? formatter.open(text.data()) : text.data();
+        end = formatter.format(end, values.data(), count);
+        out.write(text.data(), end - text.data());
+    }
+
+    out.flush();
+}
+
+#if defined(DATASET_POSIX_IO)
+
+// ********** FILESINK **********
+
+//Constructor
+inline dataset_detail::FileSink::FileSink(const int fd, const size_t bytes): fd(fd), used(0)
+{
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags == -1)
+        throw std::system_error(errno, std::generic_category(), "invalid output descriptor");
+
+#if defined(O_DIRECT)
+    direct = (flags & O_DIRECT) != 0;
+#else
+    direct = false;
+#endif
+
+    //Whole blocks, and room for at least a few of them
+    capacity = std::max<size_t>(bytes, 16 * DIRECT_ALIGNMENT) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT;
+    block = static_cast<char*>(::operator new(2 * capacity, std::align_val_t(DIRECT_ALIGNMENT)));
+    current = block;
+}
+
+//Destructor
+inline dataset_detail::FileSink::~FileSink()
+{
+    //A write may still be reading the other buffer (its error, if any, is lost: call 'finish()' to see it)
+    if (pending.valid())
+        pending.wait();
+
+    ::operator delete(block, std::align_val_t(DIRECT_ALIGNMENT));
+}
+
+//Write out the current buffer in the background
+inline void dataset_detail::FileSink::submit()
+{
+    //The other buffer becomes free once its write is done
+    if (pending.valid())
+        pending.get();
+
+    char* full = current;
+    current = current == block ? block + capacity : block;
+
+    //'O_DIRECT' writes whole blocks: keep the remainder for the next buffer
+    const size_t aligned = direct ? used / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT : used;
+    std::memcpy(current, full + aligned, used - aligned);
+    used -= aligned;
+
+    const int destination = fd;
+    pending = std::async(std::launch::async, [destination, full, aligned]() { writeAll(destination, full, aligned); });
+}
+
+//Largest 'reserve()' that is always possible (a carried-over remainder is less than one block)
+inline size_t dataset_detail::FileSink::space() const noexcept
+{
+    return capacity - DIRECT_ALIGNMENT;
+}
+
+//Room for 'bytes' more bytes
+inline char* dataset_detail::FileSink::reserve(const size_t bytes)
+{
+    if (used + bytes > capacity)
+        submit();
+
+    return current + used;
+}
+
+//Keep what was written into the reserved room
+inline void dataset_detail::FileSink::commit(const size_t bytes) noexcept
+{
+    used += bytes;
+}
+
+//Write everything still buffered
+inline void dataset_detail::FileSink::finish()
+{
+    if (pending.valid())
+        pending.get();
+
+    //Whole blocks first, then (with 'O_DIRECT' cleared, as the end of a file needn't be a whole block) the rest
+    const size_t aligned = direct ? used / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT : used;
+    writeAll(fd, current, aligned);
+
+#if defined(O_DIRECT)
+    if (aligned != used)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+        direct = false;
+    }
+#endif
+
+    writeAll(fd, current + aligned, used - aligned);
+    used = 0;
+}
+
+// ********** WRITERS **********
+
+//Write 'length' elements, generated chunk by chunk straight into the output buffers
+template <typename T, typename Fill>
+void dataset_detail::writeStream(const int fd, const size_t length, const Output& output, Fill fill)
+{
+    FileSink sink(fd, output.buffer);
+
+    if (output.format == Format::BINARY)
+    {
+        //Little-endian on every host: big-endian hosts swap bytes in place
+        const size_t perChunk = sink.space() / sizeof(T);
+
+        for(size_t first=0; first < length; first += perChunk)
+        {
+            const size_t count = std::min(perChunk, length - first);
+            T* values = reinterpret_cast<T*>(sink.reserve(count * sizeof(T)));
+            fill(values, first, count);
+
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            for(size_t k=0; k < count; k++)
+            {
+                unsigned char* bytes = reinterpret_cast<unsigned char*>(values + k);
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+#endif
+
+            sink.commit(count * sizeof(T));
+        }
+    }
+    else if (output.format == Format::PACKED)
+    {
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        throw std::invalid_argument("invalid format; packed files are written on little-endian hosts only.");
+#endif
+        //The header, then every block encoded straight into the output buffer (blocks shrink if a raw one wouldn't fit in it)
+        const size_t room = sink.space() > sizeof(PackedBlock) ? sink.space() - sizeof(PackedBlock) : 0;
+        const size_t block = std::min(PACKED_BLOCK, room / sizeof(T) / PACKED_LANES * PACKED_LANES);
+        if (block == 0)
+            throw std::invalid_argument("invalid buffer; a packed block doesn't fit in the output buffer.");
+
+        PackedHeader header = {{'D', 'S', 'P', 'A', 'C', 'K', 'E', 'D'}, PACKED_VERSION, static_cast<std::uint32_t>(sizeof(T) | isSigned<T> << 8 | isReal<T> << 9), length, block};
+        std::memcpy(sink.reserve(sizeof(header)), &header, sizeof(header));
+        sink.commit(sizeof(header));
+
+        std::vector<T> values(std::min(block, length));
+        PackScratch scratch;
+
+        for(size_t first=0; first < length; first += block)
+        {
+            const size_t count = std::min(block, length - first);
+            fill(values.data(), first, count);
+            sink.commit(packBlock(values.data(), count, sink.reserve(packedBound<T>(count)), scratch));
+        }
+    }
+    else
+    {
+        //Text: generate a chunk, then format it straight into the output buffer
+        TextFormatter<T> formatter(output.text, length);
+        if (formatter.widest() > sink.space() / 2)
+            throw std::invalid_argument("invalid text format; the separators don't fit in the output buffer.");
+
+        const size_t perChunk = std::min(VIEW_CHUNK, sink.space() / formatter.widest() - 1);
+        std::vector<T> values(std::min(perChunk, length));
+
+        for(size_t first=0; first < length; first += perChunk)
+        {
+            const size_t count = std::min(perChunk, length - first);
+            fill(values.data(), first, count);
+
+            char* const start = sink.reserve((count + 1) * formatter.widest());
+            char* text = first == 0 ? formatter.open(start) : start;
+            text = formatter.format(text, values.data(), count);
+
+            sink.commit(static_cast<size_t>(text - start));
+        }
+    }
+
+    sink.finish();
+}
+
+//Create/truncate a file and write it
+template <typename Writer>
+void dataset_detail::writeFile(const std::string& path, const Output& output, Writer writer)
+{
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#if defined(O_DIRECT)
+    if (output.direct)
+        flags |= O_DIRECT;
+#endif
+
+    int fd = open(path.c_str(), flags, 0644);
+
+    //Some filesystems (e.g., tmpfs) refuse 'O_DIRECT': fall back to buffered writes
+    if (fd == -1 and errno == EINVAL and flags != (O_WRONLY | O_CREAT | O_TRUNC))
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd == -1)
+        throw std::system_error(errno, std::generic_category(), "cannot open '" + path + "' for writing");
+
+    try
+    {
+        writer(fd);
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+
+    if (close(fd) != 0)
+        throw std::system_error(errno, std::generic_category(), "cannot finish writing '" + path + "'");
+}
+
+//Write every byte (writes can be partial or interrupted)
+inline void dataset_detail::writeAll(const int fd, const char* bytes, size_t size)
+{
+    while (size != 0)
+    {
+        const ssize_t written = ::write(fd, bytes, size);
+
+        if (written == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "dataset write failed");
+        }
+
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+
+// ********** PACKED FILES **********
+
+//Whole rows of 8 lanes, plus a row of padding so every code is read from two neighbouring words without a branch (no bytes at all for 0-bit codes)
+inline size_t dataset_detail::packedBytes(const size_t count, const unsigned width) noexcept
+{
+    if (count == 0 or width == 0)
+        return 0;
+
+    const size_t rows = ((count + PACKED_LANES - 1) / PACKED_LANES * width + 31) / 32 + 1;
+    return rows * PACKED_LANES * sizeof(std::uint32_t);
+}
+
+//Bit-pack the codes: the 8 lanes hold codes 0, 8, 16... / 1, 9, 17... side by side, so one vector shift unpacks 8 codes at once. A row of codes
+//shares one bit offset, so each lane's word is filled in a register and stored once full (the lane loop vectorizes)
+inline void dataset_detail::packCodes(const std::uint32_t* codes, const size_t count, const unsigned width, std::uint32_t* words) noexcept
+{
+    const size_t rows = packedBytes(count, width) / (PACKED_LANES * sizeof(std::uint32_t));
+    std::uint32_t current[PACKED_LANES] = {}, spill[PACKED_LANES] = {}, tail[PACKED_LANES] = {};
+    size_t row = 0;
+    unsigned bit = 0;
+
+    for(size_t first=0; first < count; first += PACKED_LANES)
+    {
+        //The last row, if not whole, is padded with zeros
+        const std::uint32_t* code = codes + first;
+        if (count - first < PACKED_LANES)
+            code = static_cast<const std::uint32_t*>(std::memcpy(tail, code, (count - first) * sizeof(std::uint32_t)));
+
+        for(size_t lane=0; lane < PACKED_LANES; lane++)
+        {
+            const std::uint64_t shifted = static_cast<std::uint64_t>(code[lane]) << bit;
+            current[lane] |= static_cast<std::uint32_t>(shifted);
+            spill[lane] = static_cast<std::uint32_t>(shifted >> 32);
+        }
+
+        bit += width;
+        if (bit >= 32)
+        {
+            std::memcpy(words + row++ * PACKED_LANES, current, sizeof(current));
+            std::memcpy(current, spill, sizeof(current));
+            bit -= 32;
+        }
+    }
+
+    //The word being filled, then zeros up to the end (the padding row)
+    if (row < rows)
+        std::memcpy(words + row++ * PACKED_LANES, current, sizeof(current));
+    std::memset(words + row * PACKED_LANES, 0, (rows - row) * PACKED_LANES * sizeof(std::uint32_t));
+}
+
+//Scalar kernel: each code from its two words, a row of 8 at a time
+inline void dataset_detail::unpackScalar(const std::uint32_t* words, const size_t count, const unsigned width, std::uint32_t* codes) noexcept
+{
+    const std::uint32_t mask = width == 32 ? ~0u : (1u << width) - 1;
+
+    for(size_t row=0, bit=0; row * PACKED_LANES < count; row++, bit += width)
+    {
+        const std::uint32_t* low = words + bit / 32 * PACKED_LANES;
+        for(size_t lane=0; lane < PACKED_LANES; lane++)
+        {
+            const std::uint64_t pair = static_cast<std::uint64_t>(low[lane + PACKED_LANES]) << 32 | low[lane];
+            codes[row * PACKED_LANES + lane] = static_cast<std::uint32_t>(pair >> (bit % 32)) & mask;
+        }
+    }
+}
+
+#if defined(DATASET_X86_SIMD)
+
+//AVX2 kernel: a row is one vector, shifted out of its two words (a shift by 32 gives 0, so codes that fit in one word need no branch)
+__attribute__((target("avx2")))
+inline void dataset_detail::unpackAVX2(const std::uint32_t* words, const size_t count, const unsigned width, std::uint32_t* codes) noexcept
+{
+    const __m256i mask = _mm256_set1_epi32(static_cast<int>(width == 32 ? ~0u : (1u << width) - 1));
+
+    for(size_t row=0, bit=0; row * PACKED_LANES < count; row++, bit += width)
+    {
+        const __m256i* low = reinterpret_cast<const __m256i*>(words + bit / 32 * PACKED_LANES);
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(bit % 32)), left = _mm_cvtsi32_si128(static_cast<int>(32 - bit % 32));
+        const __m256i code = _mm256_or_si256(_mm256_srl_epi32(_mm256_loadu_si256(low), right), _mm256_sll_epi32(_mm256_loadu_si256(low + 1), left));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + row * PACKED_LANES), _mm256_and_si256(code, mask));
+    }
+}
+
+#endif
+
+//Pick the fastest kernel
+inline dataset_detail::UnpackKernel dataset_detail::unpackKernel() noexcept
+{
+    static const UnpackKernel kernel = []() noexcept -> UnpackKernel
+    {
+#if defined(DATASET_X86_SIMD)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return unpackAVX2;
+#endif
+        return unpackScalar;
+    }();
+
+    return kernel;
+}
+
+template <typename T>
+constexpr size_t dataset_detail::packedBound(const size_t count) noexcept
+{
+    return sizeof(PackedBlock) + (count * sizeof(T) + 7) / 8 * 8;
+}
+
+//Encode a block whichever way is the smallest: as differences from a neighbour (integers), as indices into a dictionary (few different values), or raw
+template <typename T>
+size_t dataset_detail::packBlock(const T* values, const size_t count, char* out, PackScratch& scratch)
+{
+    PackedBlock block = {Encoding::RAW, 0, 0, static_cast<std::uint32_t>(count), 0, 0, (count * sizeof(T) + 7) / 8 * 8};
+    char* payload = out + sizeof(PackedBlock);
+    std::vector<std::uint32_t>& codes = scratch.codes;
+    codes.resize(count);
+
+    //DELTA: every difference from the previous element, less the smallest one, must fit in 32 bits (sorted, reverse sorted, sawtooth...)
+    unsigned deltaWidth = 33;
+    if constexpr (deltaPacked<T>)
+    {
+        using U = std::make_unsigned_t<T>;
+        using S = std::make_signed_t<T>;
+        S low = std::numeric_limits<S>::max(), high = std::numeric_limits<S>::min();
+
+        for(size_t i=1; i < count; i++)
+        {
+            const S difference = static_cast<S>(static_cast<U>(static_cast<U>(values[i]) - static_cast<U>(values[i - 1])));
+            low = std::min(low, difference);
+            high = std::max(high, difference);
+        }
+
+        const std::uint64_t widest = count > 1 ? static_cast<U>(static_cast<U>(high) - static_cast<U>(low)) : 0;
+        if (widest <= 0xFFFFFFFF)
+        {
+            deltaWidth = 0;
+            while ((widest >> deltaWidth) != 0)
+                deltaWidth++;
+
+            const size_t bytes = packedBytes(count - 1, deltaWidth);
+            if (bytes < block.bytes)
+            {
+                block = {Encoding::DELTA, static_cast<std::uint8_t>(deltaWidth), 0, static_cast<std::uint32_t>(count), static_cast<U>(values[0]), static_cast<U>(low), bytes};
+            }
+        }
+    }
+
+    //DICTIONARY: the different bit patterns, in order of appearance (given up once it holds too many to pay off)
+    if constexpr (sizeof(T) <= 8)
+    {
+        constexpr unsigned SLOT_BITS = 15;       //Twice 'PACKED_ENTRIES' slots: the table is at most half full
+        static_assert(size_t(1) << SLOT_BITS == 2 * PACKED_ENTRIES, "the dictionary's hash table must have twice 'PACKED_ENTRIES' slots");
+
+        //The keys sit in the table itself, so a lookup is one probe, not a probe and then a load from the entries (listed once the block is done:
+        //growing a vector in this loop keeps the compiler from holding anything in registers)
+        scratch.keys.resize(size_t(1) << SLOT_BITS);
+        scratch.slots.assign(size_t(1) << SLOT_BITS, 0);
+        std::uint64_t* keys = scratch.keys.data();
+        std::uint32_t* slots = scratch.slots.data();
+        const size_t limit = std::min(PACKED_ENTRIES, block.bytes / sizeof(T));    //Past this many entries the dictionary alone is as big as the block
+        std::uint32_t entries = 0;
+        bool fits = true;
+
+        for(size_t i=0; i < count and fits; i++)
+        {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, values + i, sizeof(T));
+
+            size_t slot = static_cast<size_t>((bits * 0x9E3779B97F4A7C15ull) >> (64 - SLOT_BITS));
+            while (slots[slot] != 0 and keys[slot] != bits)
+                slot = (slot + 1) & ((size_t(1) << SLOT_BITS) - 1);
+
+            if (slots[slot] == 0)
+            {
+                keys[slot] = bits;
+                slots[slot] = ++entries;
+                fits = entries < limit;
+            }
+
+            codes[i] = slots[slot] - 1;
+        }
+
+        unsigned width = 0;
+        while (fits and (std::uint32_t(1) << width) < entries)
+            width++;
+
+        const size_t dictionary = (entries * sizeof(T) + 7) / 8 * 8, bytes = dictionary + packedBytes(count, width);
+        if (fits and bytes < block.bytes)
+        {
+            block = {Encoding::DICTIONARY, static_cast<std::uint8_t>(width), 0, static_cast<std::uint32_t>(count), entries, 0, bytes};
+            std::memset(payload, 0, dictionary);
+            for(size_t s=0; s < scratch.slots.size(); s++)
+                if (slots[s] != 0)
+                    std::memcpy(payload + (slots[s] - 1) * sizeof(T), keys + s, sizeof(T));      //Little-endian: the low bytes are the value
+            packCodes(codes.data(), count, width, reinterpret_cast<std::uint32_t*>(payload + dictionary));
+        }
+    }
+
+    if (block.encoding == Encoding::RAW)
+    {
+        std::memcpy(payload, values, count * sizeof(T));
+        std::memset(payload + count * sizeof(T), 0, block.bytes - count * sizeof(T));
+    }
+    else if (block.encoding == Encoding::DELTA)
+    {
+        if constexpr (deltaPacked<T>)
+        {
+            using U = std::make_unsigned_t<T>;
+            for(size_t i=1; i < count; i++)
+                codes[i - 1] = static_cast<std::uint32_t>(static_cast<U>(static_cast<U>(values[i]) - static_cast<U>(values[i - 1]) - static_cast<U>(block.step)));
+            packCodes(codes.data(), count - 1, deltaWidth, reinterpret_cast<std::uint32_t*>(payload));
+        }
+    }
+
+    std::memcpy(out, &block, sizeof(block));
+    return sizeof(PackedBlock) + block.bytes;
+}
+
+//Decode a block: unpack its codes (SIMD), then add the differences up or look the indices up. 'codes' holds a whole block
+template <typename T>
+const char* dataset_detail::unpackBlock(const char* at, const char* end, T* out, std::vector<std::uint32_t>& codes)
+{
+    PackedBlock block;
+    const size_t left = static_cast<size_t>(end - at);
+    if (left < sizeof(block))
+        throw std::invalid_argument("invalid file; a packed block is cut short.");
+
+    std::memcpy(&block, at, sizeof(block));
+    const char* payload = at + sizeof(block);
+    const size_t count = block.count;
+
+    //Everything a corrupt header could make the decoder read past
+    const bool delta = block.encoding == Encoding::DELTA and deltaPacked<T>, dictionary = block.encoding == Encoding::DICTIONARY and sizeof(T) <= 8;
+    const size_t needed = block.encoding == Encoding::RAW ? count * sizeof(T) : delta ? packedBytes(count - 1, block.width)
+                        : (block.first * sizeof(T) + 7) / 8 * 8 + packedBytes(count, block.width);
+
+    if (block.bytes > left - sizeof(block) or count == 0 or count > codes.size() or block.width > 32 or block.bytes < needed
+        or (block.encoding != Encoding::RAW and not delta and not (dictionary and block.first != 0 and block.first <= count)))
+        throw std::invalid_argument("invalid file; a packed block is corrupt.");
+
+    if (block.encoding == Encoding::RAW)
+    {
+        std::memcpy(out, payload, count * sizeof(T));
+        return payload + block.bytes;
+    }
+
+    const size_t coded = delta ? count - 1 : count;
+    if (block.width == 0)
+        std::fill(codes.begin(), codes.begin() + coded, 0);
+    else
+        unpackKernel()(reinterpret_cast<const std::uint32_t*>(payload + (delta ? 0 : needed - packedBytes(count, block.width))), coded, block.width, codes.data());
+
+    if constexpr (deltaPacked<T>)
+    {
+        if (delta)
+        {
+            using U = std::make_unsigned_t<T>;
+            const U step = static_cast<U>(block.step);
+            U value = static_cast<U>(block.first);
+            out[0] = static_cast<T>(value);
+
+            for(size_t i=1; i < count; i++)
+            {
+                value = static_cast<U>(value + static_cast<U>(codes[i - 1]) + step);
+                out[i] = static_cast<T>(value);
+            }
+        }
+    }
+
+    if constexpr (sizeof(T) <= 8)
+    {
+        if (not delta)
+        {
+            //Indices are clamped, so a corrupt one can't read past the dictionary
+            const T* entries = reinterpret_cast<const T*>(payload);
+            const std::uint32_t last = static_cast<std::uint32_t>(block.first - 1);
+            for(size_t i=0; i < count; i++)
+                out[i] = entries[std::min(codes[i], last)];
+        }
+    }
+
+    return payload + block.bytes;
+}
+
+#endif
+
+
+/*
+    +----------------------------+
+    | DatasetBase Implementation |
+    +----------------------------+
+*/
+
+// ********** PRIVATE METHODS ********** //
+
+//The derived class' internal array
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr T* DatasetBase<Derived, T, dataT, Engine>::data() noexcept
+{
+    return static_cast<Derived*>(this)->dataset;
+}
+
+//The derived class' internal array (read-only)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr const T* DatasetBase<Derived, T, dataT, Engine>::data() const noexcept
+{
+    return static_cast<const Derived*>(this)->dataset;
+}
+
+//The derived class' length
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr size_t DatasetBase<Derived, T, dataT, Engine>::count() const noexcept
+{
+    return static_cast<const Derived*>(this)->length;
+}
+
+// ********** PUBLIC METHODS **********
+
+//Generate a new dataset
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max)
+{
+    //Unseeded: reuse this thread's engine instead of building + seeding a new one every call
+    genNewData(min, max, dataset_detail::threadEngine<Engine>());
+}
+
+//Generate a new dataset from a seed
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const std::uint64_t seed)
+{
+    Engine RNG = dataset_detail::seededEngine<Engine>(seed);
+    genNewData(min, max, RNG);
+}
+
+//Generate a new dataset from the caller's engine
+template <typename Derived, typename T, DT dataT, typename Engine>
+template <typename Generator, typename>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, Generator& RNG)
+{
+    if constexpr (dataT == DT::FEW_UNIQUE)
+        dataset_detail::genUniqueData(data(), count(), min, max, RNG);
+    else if constexpr (dataT == DT::PERMUTATION or dataT == DT::DISTINCT)
+        dataset_detail::genDistinctData<dataT>(data(), count(), min, max, RNG);
+    else if constexpr (dataset_detail::isPattern(dataT))
+        dataset_detail::genPatternData<dataT>(data(), count(), min, max, RNG);
+    else
+        dataset_detail::genRandomData<dataT>(data(), count(), min, max, RNG);  //sorting is automatically taken care of here
+
+}
+
+//Generate a new dataset on several threads
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const Parallel parallel)
+{
+    if constexpr (dataT == DT::FEW_UNIQUE)
+        dataset_detail::genUniqueDataParallel(data(), count(), min, max, parallel);
+    else if constexpr (dataT == DT::PERMUTATION or dataT == DT::DISTINCT)
+        dataset_detail::genDistinctDataParallel<dataT>(data(), count(), min, max, parallel);
+    else if constexpr (dataset_detail::isPattern(dataT))
+        dataset_detail::genPatternDataParallel<dataT>(data(), count(), min, max, parallel);
+    else
+        dataset_detail::genRandomDataParallel<dataT>(data(), count(), min, max, parallel);
+}
+
+//Generate a new dataset in a constant expression
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const CompileTime compile)
+{
+    dataset_detail::genConstantData<dataT>(data(), count(), min, max, compile.seed);
+}
+
+//Generate a new dataset with a distribution's values
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const Distribution& distribution)
+{
+    dataset_detail::genShapedData<dataT>(data(), count(), min, max, distribution, dataset_detail::threadEngine<Engine>());
+}
+
+//Generate a new dataset with a distribution's values from a seed
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const Distribution& distribution, const std::uint64_t seed)
+{
+    Engine RNG = dataset_detail::seededEngine<Engine>(seed);
+    dataset_detail::genShapedData<dataT>(data(), count(), min, max, distribution, RNG);
+}
+
+//Generate a new dataset with a distribution's values on several threads
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const Distribution& distribution, const Parallel parallel)
+{
+    dataset_detail::genShapedDataParallel<dataT>(data(), count(), min, max, distribution, parallel);
+}
+
+//Generate one shard of a parallel dataset: every worker computes its part of the shard's range through its own copy of one producer (the copies share
+//its views, so the sorted types' bucket sizes, and with them the values at the shard's boundaries, are derived once from the seed)
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const T min, const T max, const Shard& shard, const Parallel parallel)
+{
+    const std::pair<size_t, size_t> range = shardRange(shard);
+    if (range.second - range.first != count())
+        throw std::invalid_argument("invalid shard; the dataset must have as many elements as the shard.");
+
+    const DatasetProducer<T, dataT> producer(shard.total, min, max, parallel.seed);
+    T* const output = data();
+
+    dataset_detail::parallelFor(count(), parallel.threads, [&](const size_t first, const size_t last)
+    {
+        DatasetProducer<T, dataT> own = producer;    //(SAWTOOTH producers keep the run they computed last)
+        own.fill(output + first, range.first + first, last - first);
+    });
+}
+
+//Generate keys that collide in a hash table from a seed
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const Collisions& collisions, const std::uint64_t seed)
+{
+    static_assert(dataT == DT::DISTINCT and std::is_integral<T>::value and sizeof(T) == 8, "colliding keys are different 64-bit integers: use a DISTINCT dataset of std::uint64_t or std::int64_t");
+    if (count() - 1 > collisions.last())
+        throw std::invalid_argument("invalid collisions; the bucket holds fewer keys than the dataset has elements.");
+
+    //Different indices of the colliding hash values, each turned into its key
+    std::uint64_t* keys = reinterpret_cast<std::uint64_t*>(data());     //(the signed and unsigned types may alias each other)
+    Engine RNG = dataset_detail::seededEngine<Engine>(seed);
+    dataset_detail::genDistinctData<DT::DISTINCT>(keys, count(), std::uint64_t(0), collisions.last(), RNG);
+
+    for(size_t i=0; i < count(); i++)
+        keys[i] = collisions.key(keys[i]);
+}
+
+//Generate keys that collide in a hash table on several threads
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::genNewData(const Collisions& collisions, const Parallel parallel)
+{
+    static_assert(dataT == DT::DISTINCT and std::is_integral<T>::value and sizeof(T) == 8, "colliding keys are different 64-bit integers: use a DISTINCT dataset of std::uint64_t or std::int64_t");
+    if (count() - 1 > collisions.last())
+        throw std::invalid_argument("invalid collisions; the bucket holds fewer keys than the dataset has elements.");
+
+    std::uint64_t* keys = reinterpret_cast<std::uint64_t*>(data());
+    dataset_detail::genDistinctDataParallel<DT::DISTINCT>(keys, count(), std::uint64_t(0), collisions.last(), parallel);
+
+    dataset_detail::parallelFor(count(), parallel.threads, [&](const size_t first, const size_t last)
+    {
+        for(size_t i=first; i < last; i++)
+            keys[i] = collisions.key(keys[i]);
+    });
+}
+
+//Generate a new dataset on several threads, and its multiset checksum: every worker fills its range a block at a time through its own copy of one
+//producer (see 'genNewData(min, max, shard, parallel)'), and hashes each block right after it is made. PERMUTATION and DISTINCT datasets are made whole,
+//so their checksum is summed afterwards
+template <typename Derived, typename T, DT dataT, typename Engine>
+std::uint64_t DatasetBase<Derived, T, dataT, Engine>::genNewDataChecked(const T min, const T max, const Parallel parallel)
+{
+    if constexpr (dataT == DT::PERMUTATION or dataT == DT::DISTINCT)
+    {
+        genNewData(min, max, parallel);
+        return multisetChecksum(DatasetSpan<const T>(data(), count()), parallel.threads);
+    }
+    else
+    {
+        const DatasetProducer<T, dataT> producer(count(), min, max, parallel.seed);
+        T* const output = data();
+        std::atomic<std::uint64_t> sum(0);
+
+        dataset_detail::parallelFor(count(), parallel.threads, [&](const size_t first, const size_t last)
+        {
+            DatasetProducer<T, dataT> own = producer;
+            std::uint64_t local = 0;
+
+            for(size_t done=first; done < last; done += own.blockSize())
+            {
+                const size_t amount = std::min(own.blockSize(), last - done);
+                own.fill(output + done, done, amount);
+                local += dataset_detail::hashSum(output + done, amount);
+            }
+
+            sum += local;
+        });
+
+        return sum;
+    }
+}
+
+//Generate a new dataset on a background thread from a seed
+template <typename Derived, typename T, DT dataT, typename Engine>
+std::future<void> DatasetBase<Derived, T, dataT, Engine>::genNewDataAsync(const T min, const T max, const std::uint64_t seed)
+{
+    return std::async(std::launch::async, [this, min, max, seed]() { genNewData(min, max, seed); });
+}
+
+//Generate a new dataset on background threads
+template <typename Derived, typename T, DT dataT, typename Engine>
+std::future<void> DatasetBase<Derived, T, dataT, Engine>::genNewDataAsync(const T min, const T max, const Parallel parallel)
+{
+    return std::async(std::launch::async, [this, min, max, parallel]() { genNewData(min, max, parallel); });
+}
+
+//Generate McIlroy's adversary for a sort
+template <typename Derived, typename T, DT dataT, typename Engine>
+template <typename Sort>
+void DatasetBase<Derived, T, dataT, Engine>::genAdversary(const T min, Sort sort)
+{
+    using U = typename std::conditional<dataset_detail::isReal<T>, T, typename dataset_detail::unsignedOf<T>::type>::type;
+
+    //The values are min, min + 1... min + size - 1, so the largest has to fit the type
+    if constexpr (not dataset_detail::isReal<T>)
+    {
+        const U highest = dataset_detail::isSigned<T> ? static_cast<U>(static_cast<U>(~U(0)) >> 1) : static_cast<U>(~U(0));
+        if (static_cast<U>(highest - static_cast<U>(min)) < static_cast<U>(count() - 1))
+            throw std::invalid_argument("invalid minimum; an adversary needs the values min to min + size - 1 to fit the type.");
+    }
+
+    thread_local std::vector<size_t> ranks;     //Reused by the next adversary this thread generates
+    dataset_detail::antiQuicksort(ranks, count(), sort);
+
+    for(size_t i=0; i < count(); i++)
+        data()[i] = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(ranks[i])));
+}
+
+//Disturb the current order
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::perturb(const Disorder& disorder)
+{
+    dataset_detail::perturbData(data(), count(), disorder, dataset_detail::threadEngine<Engine>());
+}
+
+//Disturb the current order from a seed
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::perturb(const Disorder& disorder, const std::uint64_t seed)
+{
+    Engine RNG = dataset_detail::seededEngine<Engine>(seed);
+    dataset_detail::perturbData(data(), count(), disorder, RNG);
+}
+
+//Return a pointer to the array (not really necessary because of implicit T* conversion)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr T* DatasetBase<Derived, T, dataT, Engine>::get() noexcept
+{
+    //Return a pointer to the internal array
+    return data();
+}
+
+//Return a read-only pointer to the array
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr const T* DatasetBase<Derived, T, dataT, Engine>::get() const noexcept
+{
+    //Return a pointer to the internal array
+    return data();
+}
+
+//Print
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::print(std::ostream& out, const TextFormat& layout) const
+{
+    //Print all the values of the array
+    dataset_detail::printStream<T>(out, count(), layout, [&](T* buffer, const size_t first, const size_t amount)
+    {
+        std::copy(data() + first, data() + first + amount, buffer);
+    });
+}
+
+
+#if defined(DATASET_POSIX_IO)
+//Write to a file
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::write(const std::string& path, const Output& output) const
+{
+    dataset_detail::writeFile(path, output, [&](const int fd) { write(fd, output); });
+}
+
+//Write to a descriptor
+template <typename Derived, typename T, DT dataT, typename Engine>
+void DatasetBase<Derived, T, dataT, Engine>::write(const int fd, const Output& output) const
+{
+    dataset_detail::writeStream<T>(fd, count(), output, [&](T* buffer, const size_t first, const size_t amount)
+    {
+        std::copy(data() + first, data() + first + amount, buffer);
+    });
+}
+#endif
+
+
+// ********** ITERATORS **********
+
+//Begin iterator
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr T* DatasetBase<Derived, T, dataT, Engine>::begin() noexcept
+{
+    //Return the address of the first element in the array
+    return data();
+}
+
+
+//End iterator
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr T* DatasetBase<Derived, T, dataT, Engine>::end() noexcept
+{
+    //Return the address one past the last element in the array
+    return data() + count();
+}
+
+//Begin iterator (read-only)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr const T* DatasetBase<Derived, T, dataT, Engine>::begin() const noexcept
+{
+    //Return the address of the first element in the array
+    return data();
+}
+
+//End iterator (read-only)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr const T* DatasetBase<Derived, T, dataT, Engine>::end() const noexcept
+{
+    //Return the address one past the last element in the array
+    return data() + count();
+}
+
+// ********** OPERATOR OVERLOADING **********
+
+//T* Conversion Overload (returns a pointer to the internal array of type T)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr DatasetBase<Derived, T, dataT, Engine>::operator T*()
+{
+    //The name of the array is a pointer to the first element
+    return data();
+}
+
+//const T* Conversion Overload (returns a read-only pointer to the internal array of type T)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr DatasetBase<Derived, T, dataT, Engine>::operator const T*() const
+{
+    return data();
+}
+
+//[] Overload
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr T& DatasetBase<Derived, T, dataT, Engine>::operator[](const size_t index)
+{
+    return data()[index];
+}
+
+//[] Overload (read-only)
+template <typename Derived, typename T, DT dataT, typename Engine>
+constexpr const T& DatasetBase<Derived, T, dataT, Engine>::operator[](const size_t index) const
+{
+    return data()[index];
+}
+
+/*
+    +----------------------------+
+    |   Dataset Implementation   |
+    +----------------------------+
+*/
+
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor
+template <typename T, size_t size, DT dataT, typename Engine>
+constexpr Dataset<T, size, dataT, Engine>::Dataset(const T min, const T max)
+{
+    dataset_detail::checkRange(min, max);
+
+    //Generate new data (random, sorted, reverse-sorted, nearly-sorted, or few-unique)
+    this->genNewData(min, max);
+}
+
+//Constructor (seeded)
+template <typename T, size_t size, DT dataT, typename Engine>
+Dataset<T, size, dataT, Engine>::Dataset(const T min, const T max, const std::uint64_t seed)
+{
+    //Generate new data that only depends on the seed (the range is validated by the generator)
+    this->genNewData(min, max, seed);
+}
+
+//Constructor (parallel)
+template <typename T, size_t size, DT dataT, typename Engine>
+Dataset<T, size, dataT, Engine>::Dataset(const T min, const T max, const Parallel parallel)
+{
+    //Generate new data on several threads (the range is validated by the generator)
+    this->genNewData(min, max, parallel);
+}
+
+//Constructor (compile time)
+template <typename T, size_t size, DT dataT, typename Engine>
+constexpr Dataset<T, size, dataT, Engine>::Dataset(const T min, const T max, const CompileTime compile): dataset{}
+{
+    //Constant expressions can't read uninitialized memory, so the array is zeroed first (for a 'constexpr' dataset, that costs nothing at runtime)
+    this->genNewData(min, max, compile);
+}
+
+/*
+    +-----------------------------------+
+    |   DynamicDataset Implementation   |
+    +-----------------------------------+
+*/
+
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor (heap or huge pages)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Memory source): dataset(acquire(size, min, max, source)), source(source), elements(size), length(elements)
+{
+    populate(min, max);
+}
+
+//Constructor (heap or huge pages, seeded)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const std::uint64_t seed, const Memory source): dataset(acquire(size, min, max, source)), source(source), elements(size), length(elements)
+{
+    populate(min, max, seed);
+}
+
+//Constructor (heap or huge pages, parallel)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Parallel parallel, const Memory source): dataset(acquire(size, min, max, source)), source(source), elements(size), length(elements)
+{
+    populate(min, max, parallel);
+}
+
+//Constructor (distribution, seeded)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Distribution& distribution, const std::uint64_t seed, const Memory source):
+    dataset(acquire(size, min, max, source)), source(source), elements(size), length(elements)
+{
+    populate(min, max, distribution, seed);
+}
+
+//Constructor (distribution, parallel)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Distribution& distribution, const Parallel parallel, const Memory source):
+    dataset(acquire(size, min, max, source)), source(source), elements(size), length(elements)
+{
+    populate(min, max, distribution, parallel);
+}
+
+//Constructor (NUMA placement, parallel): every worker of the fill touches its own range first
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Parallel parallel, const Numa& numa):
+    dataset(acquire(size, min, max, numa)), source(Memory::NUMA), elements(size), length(elements)
+{
+    populate(min, max, parallel);
+}
+
+//Constructor (NUMA placement, distribution, parallel)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Distribution& distribution, const Parallel parallel, const Numa& numa):
+    dataset(acquire(size, min, max, numa)), source(Memory::NUMA), elements(size), length(elements)
+{
+    populate(min, max, distribution, parallel);
+}
+
+//Constructor (colliding keys, parallel)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const Collisions& collisions, const Parallel parallel, const Memory source):
+    dataset(acquire(size, T(0), T(0), source)), source(source), elements(size), length(elements)
+{
+    populate(collisions, parallel);
+}
+
+//Constructor (shard, parallel)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const Shard& shard, const T min, const T max, const Parallel parallel, const Memory source):
+    dataset(acquire(shardRange(shard).second - shardRange(shard).first, min, max, source)), source(source), elements(shardRange(shard).second - shardRange(shard).first), length(elements)
+{
+    populate(min, max, shard, parallel);
+}
+
+//Constructor (arena)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, Arena& arena, const T min, const T max): dataset(acquire(size, min, max, Memory::ARENA, &arena)), source(Memory::ARENA), elements(size), length(elements)
+{
+    populate(min, max);
+}
+
+//Constructor (arena, seeded)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, Arena& arena, const T min, const T max, const std::uint64_t seed): dataset(acquire(size, min, max, Memory::ARENA, &arena)), source(Memory::ARENA), elements(size), length(elements)
+{
+    populate(min, max, seed);
+}
+
+//Constructor (arena, parallel)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, Arena& arena, const T min, const T max, const Parallel parallel): dataset(acquire(size, min, max, Memory::ARENA, &arena)), source(Memory::ARENA), elements(size), length(elements)
+{
+    populate(min, max, parallel);
+}
+
+#if defined(DATASET_POSIX_IO)
+//Constructor (cached, seeded)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const std::uint64_t seed, const Cache& cache): dataset(nullptr), source(Memory::MAPPED), elements(size), length(elements)
+{
+    load(cache, min, max, seed, typeid(Engine).name());
+}
+
+//Constructor (cached, parallel: the engine is always Philox, and the thread count doesn't change the data)
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(const size_t size, const T min, const T max, const Parallel parallel, const Cache& cache): dataset(nullptr), source(Memory::MAPPED), elements(size), length(elements)
+{
+    load(cache, min, max, parallel, "Philox4x32-10");
+}
+#endif
+
+//Move constructor
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::DynamicDataset(DynamicDataset&& other) noexcept: dataset(other.dataset), source(other.source), elements(other.elements), length(elements)
+{
+    //An empty heap dataset: nothing to free, and 'count()' is 0
+    other.dataset = nullptr;
+    other.source = Memory::HEAP;
+    other.elements = 0;
+}
+
+//Move assignment
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>& DynamicDataset<T, dataT, Engine>::operator=(DynamicDataset&& other) noexcept
+{
+    //The old array goes to the temporary, which frees it
+    DynamicDataset(std::move(other)).swap(*this);
+    return *this;
+}
+
+//Destructor
+template <typename T, DT dataT, typename Engine>
+DynamicDataset<T, dataT, Engine>::~DynamicDataset()
+{
+    if (dataset != nullptr and source != Memory::ARENA)
+        dataset_detail::deallocate(dataset, length * sizeof(T), source);
+}
+
+// ********** PRIVATE METHODS **********
+
+//Validate + allocate (before generating, so an invalid range never costs an allocation)
+template <typename T, DT dataT, typename Engine>
+T* DynamicDataset<T, dataT, Engine>::acquire(const size_t size, const T min, const T max, const Memory source, Arena* arena)
+{
+    if (size == 0)
+        throw std::invalid_argument("invalid size; a dataset must have at least one element.");
+
+    dataset_detail::checkRange(min, max);
+
+    if (source == Memory::ARENA and arena == nullptr)
+        throw std::invalid_argument("invalid memory source; pass the 'Arena' itself to use arena storage.");
+
+    if (source == Memory::MAPPED)
+        throw std::invalid_argument("invalid memory source; pass a 'Cache' to use mapped storage.");
+
+    if (size > std::numeric_limits<size_t>::max() / sizeof(T))
+        throw std::bad_alloc();
+
+    //The arena owns its memory; everything else comes from 'dataset_detail::allocate()'
+    if (arena != nullptr)
+        return static_cast<T*>(arena->allocate(size * sizeof(T), DATASET_ALIGNMENT));
+
+    return static_cast<T*>(dataset_detail::allocate(size * sizeof(T), source));
+}
+
+//Validate + allocate untouched pages + set their placement
+template <typename T, DT dataT, typename Engine>
+T* DynamicDataset<T, dataT, Engine>::acquire(const size_t size, const T min, const T max, const Numa& numa)
+{
+    T* pages = acquire(size, min, max, Memory::NUMA);
+
+    try
+    {
+        dataset_detail::place(pages, size * sizeof(T), numa);
+    }
+    catch (...)
+    {
+        dataset_detail::deallocate(pages, size * sizeof(T), Memory::NUMA);
+        throw;
+    }
+
+    return pages;
+}
+
+//Generate the first dataset
+template <typename T, DT dataT, typename Engine>
+template <typename... Settings>
+void DynamicDataset<T, dataT, Engine>::populate(const Settings&... settings)
+{
+    //Generate new data (random, sorted, reverse-sorted, nearly-sorted, few-unique...)
+    try
+    {
+        this->genNewData(settings...);
+    }
+    catch (...)
+    {
+        //The destructor won't run for a half-built object
+        if (source != Memory::ARENA)
+            dataset_detail::deallocate(dataset, length * sizeof(T), source);
+        throw;
+    }
+}
+
+#if defined(DATASET_POSIX_IO)
+//Map the cached dataset
+template <typename T, DT dataT, typename Engine>
+template <typename Setting>
+void DynamicDataset<T, dataT, Engine>::load(const Cache& cache, const T min, const T max, const Setting setting, const char* engine)
+{
+    if (length == 0)
+        throw std::invalid_argument("invalid size; a dataset must have at least one element.");
+
+    dataset_detail::checkRange(min, max);
+
+    if (length > (std::numeric_limits<size_t>::max() - sizeof(dataset_detail::CacheHeader)) / sizeof(T))
+        throw std::bad_alloc();
+
+    std::uint64_t seed;
+    if constexpr (std::is_same<Setting, Parallel>::value)
+        seed = setting.seed;
+    else
+        seed = setting;
+
+    const dataset_detail::CacheHeader header = dataset_detail::cacheHeader<T, dataT>(length, min, max, seed, engine);
+    const std::string path = dataset_detail::cachePath(cache, header);
+
+    dataset = static_cast<T*>(dataset_detail::mapCached(path, header, cache.verify));
+    if (dataset != nullptr)
+        return;
+
+    //Not cached yet: generate straight into a new file (under a name nobody else uses), then move it into place
+    const std::string temporary = path + "." + std::to_string(getpid()) + "." + std::to_string(randomSeed()) + ".tmp";
+    dataset = static_cast<T*>(dataset_detail::createCached(temporary, length * sizeof(T)));
+
+    try
+    {
+        this->genNewData(min, max, setting);
+    }
+    catch (...)
+    {
+        dataset_detail::deallocate(dataset, length * sizeof(T), Memory::MAPPED);
+        unlink(temporary.c_str());
+        throw;
+    }
+
+    dataset_detail::publishCached(dataset, length * sizeof(T), header, temporary, path);
+
+    //Use the published file like any other cached one
+    dataset = static_cast<T*>(dataset_detail::mapCached(path, header, false));
+    if (dataset == nullptr)
+        throw std::system_error(errno, std::generic_category(), "cannot map cache file '" + path + "'");
+}
+#endif
+
+// ********** PUBLIC METHODS **********
+
+//Memory source
+template <typename T, DT dataT, typename Engine>
+Memory DynamicDataset<T, dataT, Engine>::memory() const noexcept
+{
+    return source;
+}
+
+//Exchange arrays
+template <typename T, DT dataT, typename Engine>
+void DynamicDataset<T, dataT, Engine>::swap(DynamicDataset& other) noexcept
+{
+    std::swap(dataset, other.dataset);
+    std::swap(source, other.source);
+    std::swap(elements, other.elements);
+}
+
+//Exchange arrays (found by 'std::swap'-style unqualified calls)
+template <typename T, DT dataT, typename Engine>
+void swap(DynamicDataset<T, dataT, Engine>& a, DynamicDataset<T, dataT, Engine>& b) noexcept
+{
+    a.swap(b);
+}
+
+
+/*
+    +----------------------------+
+    | DatasetView Implementation |
+    +----------------------------+
+*/
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor
+template <typename T, DT dataT>
+DatasetView<T, dataT>::DatasetView(const size_t size, const T min, const T max, const std::uint64_t seed): seed(seed), min(min), max(max), length(size)
+{
+    if (size == 0)
+        throw std::invalid_argument("invalid size; a dataset must have at least one element.");
+
+    dataset_detail::checkRange(min, max);
+
+    if constexpr (dataT == DT::FEW_UNIQUE)
+    {
+        auto shared = std::make_shared<std::vector<T>>();
+        dataset_detail::uniqueSamples(*shared, size, min, max, seed);
+        samples = std::move(shared);
+    }
+    else if constexpr (dataT != DT::RANDOM)
+    {
+        const dataset_detail::KeyMap<T> keys(min, max);
+        if (not keys.enumerable())
+            throw std::invalid_argument("invalid range; sorted views of 128-bit integers need a range narrower than 2^64.");
+
+        static std::atomic<std::uint64_t> views{0};
+        auto shared = std::make_shared<Layout>(Layout{{}, {}, ++views});
+        dataset_detail::seededPlan(shared->plan, size, keys.lowest(), keys.highest(), seed);
+
+        //Nearly sorted? Replay the swaps 'perturbData()' makes for this seed, keeping only where each touched position ends up
+        if constexpr (dataT == DT::NEARLY_SORTED)
+        {
+            Philox4x32 RNG(seed, dataset_detail::STREAM_SWAPS);
+            std::uniform_int_distribution<size_t> randomIndex(0, size-1);      //Random index generator
+            size_t amount = sqrt(sqrt(size));
+
+            std::vector<std::pair<size_t, size_t>>& moved = shared->moved;
+            const auto holder = [&](const size_t position) -> std::pair<size_t, size_t>&
+            {
+                for(std::pair<size_t, size_t>& entry : moved)
+                    if (entry.first == position)
+                        return entry;
+
+                moved.emplace_back(position, position);
+                return moved.back();
+            };
+
+            for(size_t i=0; i < amount; i++)
+            {
+                //'holder()' may grow the list, so look both positions up before touching either
+                const size_t a = randomIndex(RNG), b = randomIndex(RNG);
+                holder(a);
+                holder(b);
+                std::swap(holder(a).second, holder(b).second);
+            }
+
+            std::sort(moved.begin(), moved.end());
+        }
+
+        layout = std::move(shared);
+    }
+}
+
+// ********** PRIVATE METHODS **********
+
+//Element i of the sorted order
+template <typename T, DT dataT>
+T DatasetView<T, dataT>::sorted(const size_t i) const
+{
+    using Key = typename dataset_detail::KeyMap<T>::Key;
+    const dataset_detail::SortedPlan<Key>& plan = layout->plan;
+    const dataset_detail::KeyMap<T> keys(min, max);
+    const size_t position = dataT == DT::REVERSE_SORTED ? length - 1 - i : i;    //Buckets are stored ascending
+    const size_t bucket = plan.find(position);
+
+    if (plan.width(bucket) == 1)
+        return keys(plan.lowest(bucket));
+
+    //Keep this thread's last bucket, so neighbouring lookups only generate it once
+    thread_local struct { std::uint64_t id = 0; size_t bucket = 0; std::vector<Key> values; } cache;
+
+    if (cache.id != layout->id or cache.bucket != bucket)
+    {
+        const size_t elements = plan.offset(bucket + 1) - plan.offset(bucket);
+        cache.values.resize(elements);
+
+        dataset_detail::BucketDraws draw(seed, bucket, elements + 1);
+        dataset_detail::fillBucket(cache.values.data(), elements, plan.lowest(bucket), plan.width(bucket), false, draw);
+        cache.id = layout->id;
+        cache.bucket = bucket;
+    }
+
+    return keys(cache.values[position - plan.offset(bucket)]);
+}
+
+// ********** PUBLIC METHODS **********
+
+//Compute elements [first, first + count)
+template <typename T, DT dataT>
+void DatasetView<T, dataT>::fill(T* buffer, const size_t first, const size_t count) const
+{
+    if (first > length or count > length - first)
+        throw std::invalid_argument("invalid range; the elements must be inside the view.");
+
+    if constexpr (dataT == DT::RANDOM)
+        dataset_detail::fillStream(buffer, first, count, min, max, seed, dataset_detail::STREAM_VALUES);
+    else if constexpr (dataT == DT::FEW_UNIQUE)
+        dataset_detail::fillUnique(buffer, first, count, *samples, seed);
+    else
+    {
+        dataset_detail::fillSorted<dataT == DT::REVERSE_SORTED>(buffer, first, count, layout->plan, [&](const size_t bucket, const size_t elements)
+        {
+            return dataset_detail::BucketDraws(seed, bucket, elements + 1);
+        }, dataset_detail::KeyMap<T>(min, max));
+
+        //Nearly sorted? Patch the swapped positions
+        if constexpr (dataT == DT::NEARLY_SORTED)
+        {
+            const std::vector<std::pair<size_t, size_t>>& moved = layout->moved;
+            auto entry = std::lower_bound(moved.begin(), moved.end(), std::pair<size_t, size_t>(first, 0));
+
+            for(; entry != moved.end() and entry->first < first + count; ++entry)
+                buffer[entry->first - first] = sorted(entry->second);
+        }
+    }
+}
+
+//Stream the whole view, one chunk at a time
+template <typename T, DT dataT>
+template <typename Function>
+void DatasetView<T, dataT>::forEachChunk(Function function, const size_t chunk) const
+{
+    std::vector<T> buffer(std::max<size_t>(1, std::min(chunk, length)));
+
+    for(size_t first=0; first < length; first += buffer.size())
+    {
+        const size_t count = std::min(buffer.size(), length - first);
+        fill(buffer.data(), first, count);
+        function(static_cast<const T*>(buffer.data()), count);
+    }
+}
+
+//Number of elements
+template <typename T, DT dataT>
+size_t DatasetView<T, dataT>::size() const noexcept
+{
+    return length;
+}
+
+//Print
+template <typename T, DT dataT>
+void DatasetView<T, dataT>::print(std::ostream& out, const TextFormat& layout) const
+{
+    dataset_detail::printStream<T>(out, length, layout, [&](T* buffer, const size_t first, const size_t count) { fill(buffer, first, count); });
+}
+
+#if defined(DATASET_POSIX_IO)
+//Generate to a file
+template <typename T, DT dataT>
+void DatasetView<T, dataT>::write(const std::string& path, const Output& output) const
+{
+    dataset_detail::writeFile(path, output, [&](const int fd) { write(fd, output); });
+}
+
+//Generate to a descriptor, one buffer at a time (the elements are computed into the buffer that will be written)
+template <typename T, DT dataT>
+void DatasetView<T, dataT>::write(const int fd, const Output& output) const
+{
+    dataset_detail::writeStream<T>(fd, length, output, [&](T* buffer, const size_t first, const size_t count) { fill(buffer, first, count); });
+}
+#endif
+
+// ********** ITERATORS **********
+
+//First element
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator DatasetView<T, dataT>::begin() const noexcept
+{
+    return Iterator(this, 0);
+}
+
+//One past the last element
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator DatasetView<T, dataT>::end() const noexcept
+{
+    return Iterator(this, length);
+}
+
+// ********** OPERATOR OVERLOADING **********
+
+//Element i
+template <typename T, DT dataT>
+T DatasetView<T, dataT>::operator[](const size_t i) const
+{
+    if constexpr (dataT == DT::RANDOM)
+    {
+        T value;
+        dataset_detail::fillStream(&value, i, 1, min, max, seed, dataset_detail::STREAM_VALUES);
+        return value;
+    }
+    else if constexpr (dataT == DT::FEW_UNIQUE)
+    {
+        T value;
+        dataset_detail::fillUnique(&value, i, 1, *samples, seed);
+        return value;
+    }
+    else if constexpr (dataT == DT::NEARLY_SORTED)
+    {
+        //A swapped position holds another position's sorted element
+        const std::vector<std::pair<size_t, size_t>>& moved = layout->moved;
+        const auto entry = std::lower_bound(moved.begin(), moved.end(), std::pair<size_t, size_t>(i, 0));
+
+        return sorted(entry != moved.end() and entry->first == i ? entry->second : i);
+    }
+    else
+        return sorted(i);
+}
+
+// ********** ITERATOR IMPLEMENTATION **********
+
+//Constructor
+template <typename T, DT dataT>
+DatasetView<T, dataT>::Iterator::Iterator(const DatasetView* view, const size_t index) noexcept: view(view), index(index) {}
+
+//Dereference
+template <typename T, DT dataT>
+T DatasetView<T, dataT>::Iterator::operator*() const
+{
+    return (*view)[index];
+}
+
+//Offset dereference
+template <typename T, DT dataT>
+T DatasetView<T, dataT>::Iterator::operator[](const difference_type offset) const
+{
+    return (*view)[index + offset];
+}
+
+//Pre-increment
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator& DatasetView<T, dataT>::Iterator::operator++() noexcept
+{
+    ++index;
+    return *this;
+}
+
+//Post-increment
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator DatasetView<T, dataT>::Iterator::operator++(int) noexcept
+{
+    Iterator previous = *this;
+    ++index;
+    return previous;
+}
+
+//Pre-decrement
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator& DatasetView<T, dataT>::Iterator::operator--() noexcept
+{
+    --index;
+    return *this;
+}
+
+//Post-decrement
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator DatasetView<T, dataT>::Iterator::operator--(int) noexcept
+{
+    Iterator previous = *this;
+    --index;
+    return previous;
+}
+
+//Advance
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator& DatasetView<T, dataT>::Iterator::operator+=(const difference_type offset) noexcept
+{
+    index += offset;
+    return *this;
+}
+
+//Go back
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator& DatasetView<T, dataT>::Iterator::operator-=(const difference_type offset) noexcept
+{
+    index -= offset;
+    return *this;
+}
+
+//Advanced copy
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator DatasetView<T, dataT>::Iterator::operator+(const difference_type offset) const noexcept
+{
+    return Iterator(view, index + offset);
+}
+
+//Moved-back copy
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator DatasetView<T, dataT>::Iterator::operator-(const difference_type offset) const noexcept
+{
+    return Iterator(view, index - offset);
+}
+
+//Distance
+template <typename T, DT dataT>
+typename DatasetView<T, dataT>::Iterator::difference_type DatasetView<T, dataT>::Iterator::operator-(const Iterator& other) const noexcept
+{
+    return static_cast<difference_type>(index - other.index);
+}
+
+//Comparisons (iterators of the same view)
+template <typename T, DT dataT>
+bool DatasetView<T, dataT>::Iterator::operator==(const Iterator& other) const noexcept
+{
+    return index == other.index;
+}
+
+template <typename T, DT dataT>
+bool DatasetView<T, dataT>::Iterator::operator!=(const Iterator& other) const noexcept
+{
+    return index != other.index;
+}
+
+template <typename T, DT dataT>
+bool DatasetView<T, dataT>::Iterator::operator<(const Iterator& other) const noexcept
+{
+    return index < other.index;
+}
+
+template <typename T, DT dataT>
+bool DatasetView<T, dataT>::Iterator::operator>(const Iterator& other) const noexcept
+{
+    return index > other.index;
+}
+
+template <typename T, DT dataT>
+bool DatasetView<T, dataT>::Iterator::operator<=(const Iterator& other) const noexcept
+{
+    return index <= other.index;
+}
+
+template <typename T, DT dataT>
+bool DatasetView<T, dataT>::Iterator::operator>=(const Iterator& other) const noexcept
+{
+    return index >= other.index;
+}
+
+
+/*
+    +-----------------------------------+
+    |   DatasetProducer Implementation  |
+    +-----------------------------------+
+*/
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor
+template <typename T, DT dataT>
+DatasetProducer<T, dataT>::DatasetProducer(const size_t size, const T min, const T max, const std::uint64_t seed, const size_t bytes):
+    seed(seed), min(min), max(max), value(min), run(0), block(std::max<size_t>(1, bytes / sizeof(T))), next(0), length(size)
+{
+    if (size == 0)
+        throw std::invalid_argument("invalid size; a dataset must have at least one element.");
+
+    dataset_detail::checkRange(min, max);
+
+    if constexpr (whole)
+        stored = std::make_shared<DynamicDataset<T, dataT>>(size, min, max, Parallel{seed});
+    else if constexpr (dataT == DT::ALL_EQUAL)
+        dataset_detail::fillStream(&value, 0, 1, min, max, seed, dataset_detail::STREAM_VALUES);    //(what 'genPatternDataParallel()' repeats)
+    else if constexpr (dataT == DT::ORGAN_PIPE)
+    {
+        view.emplace(size - size / 2, min, max, dataset_detail::runSeed(seed, 0));
+        if (size / 2 > 0)
+            falling.emplace(size / 2, min, max, dataset_detail::runSeed(seed, 1));
+    }
+    else if constexpr (dataT == DT::SAWTOOTH)
+        view.emplace(std::min(dataset_detail::toothLength(size), size), min, max, dataset_detail::runSeed(seed, 0));
+    else
+        view.emplace(size, min, max, seed);
+}
+
+// ********** PUBLIC METHODS **********
+
+//Compute the next block
+template <typename T, DT dataT>
+size_t DatasetProducer<T, dataT>::nextBlock(T* buffer)
+{
+    const size_t count = std::min(block, length - next);
+    if (count > 0)
+        fill(buffer, next, count);
+
+    next += count;
+    return count;
+}
+
+//Compute elements [first, first + count)
+template <typename T, DT dataT>
+void DatasetProducer<T, dataT>::fill(T* buffer, const size_t first, const size_t count)
+{
+    if (first > length or count > length - first)
+        throw std::out_of_range("invalid range of elements; the producer's dataset is shorter.");
+
+    const size_t last = first + count;
+
+    if constexpr (whole)
+        std::copy(stored->begin() + first, stored->begin() + last, buffer);
+    else if constexpr (dataT == DT::ALL_EQUAL)
+        std::fill(buffer, buffer + count, value);
+    else if constexpr (dataT == DT::ORGAN_PIPE)
+    {
+        //Positions below 'rising' come from the rising half, the rest from the falling half
+        const size_t rising = length - length / 2;
+        const size_t split = std::min(std::max(first, rising), last);
+
+        if (split > first)
+            view->fill(buffer, first, split - first);
+        if (last > split)
+            falling->fill(buffer + (split - first), split - rising, last - split);
+    }
+    else if constexpr (dataT == DT::SAWTOOTH)
+    {
+        //Run r is a sorted view of its own seed (see 'genPatternDataParallel()'); the last one made is kept for the next block
+        const size_t tooth = dataset_detail::toothLength(length);
+
+        for(size_t done=first; done < last; )
+        {
+            const size_t current = done / tooth, start = current * tooth;
+            if (current != run)
+            {
+                view.emplace(std::min(tooth, length - start), min, max, dataset_detail::runSeed(seed, current));
+                run = current;
+            }
+
+            const size_t until = std::min(last, start + view->size());
+            view->fill(buffer + (done - first), done - start, until - done);
+            done = until;
+        }
+    }
+    else if constexpr (dataT == DT::PUSH_FRONT)
+    {
+        //Position i holds sorted position i + 1, and the last position the smallest element
+        const size_t shifted = std::min(last, length - 1);
+        if (shifted > first)
+            view->fill(buffer, first + 1, shifted - first);
+        if (last == length)
+            buffer[count - 1] = (*view)[0];
+    }
+    else if constexpr (dataT == DT::PUSH_BACK)
+    {
+        //Position 0 holds the largest element, and position i sorted position i - 1
+        const size_t from = std::max<size_t>(first, 1);
+        if (first == 0)
+            buffer[0] = (*view)[length - 1];
+        if (last > from)
+            view->fill(buffer + (from - first), from - 1, last - from);
+    }
+    else
+        view->fill(buffer, first, count);
+}
+
+//Elements per block
+template <typename T, DT dataT>
+size_t DatasetProducer<T, dataT>::blockSize() const noexcept
+{
+    return block;
+}
+
+//First element of the next block
+template <typename T, DT dataT>
+size_t DatasetProducer<T, dataT>::position() const noexcept
+{
+    return next;
+}
+
+//Start again
+template <typename T, DT dataT>
+void DatasetProducer<T, dataT>::rewind() noexcept
+{
+    next = 0;
+}
+
+
+/*
+    +----------------------------+
+    |DatasetBatch Implementation |
+    +----------------------------+
+*/
+
+// ********** DATASETSPAN **********
+
+//Constructor
+template <typename T>
+constexpr DatasetSpan<T>::DatasetSpan(T* first, const size_t length) noexcept: first(first), length(length) {}
+
+//First element
+template <typename T>
+constexpr T* DatasetSpan<T>::data() const noexcept
+{
+    return first;
+}
+
+//Number of elements
+template <typename T>
+constexpr size_t DatasetSpan<T>::size() const noexcept
+{
+    return length;
+}
+
+//Beginning of the dataset
+template <typename T>
+constexpr T* DatasetSpan<T>::begin() const noexcept
+{
+    return first;
+}
+
+//End of the dataset
+template <typename T>
+constexpr T* DatasetSpan<T>::end() const noexcept
+{
+    return first + length;
+}
+
+//Implicit conversion to pointer
+template <typename T>
+constexpr DatasetSpan<T>::operator T*() const noexcept
+{
+    return first;
+}
+
+//Element i
+template <typename T>
+constexpr T& DatasetSpan<T>::operator[](const size_t i) const noexcept
+{
+    return first[i];
+}
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor
+template <typename T>
+DatasetBatch<T>::DatasetBatch(const std::vector<BatchItem<T>>& items, const Parallel parallel, const Memory source): DatasetBatch(items, nullptr, parallel, source) {}
+
+//Constructor (distribution)
+template <typename T>
+DatasetBatch<T>::DatasetBatch(const std::vector<BatchItem<T>>& items, const Distribution& distribution, const Parallel parallel, const Memory source):
+    DatasetBatch(items, std::make_shared<const Distribution>(distribution), parallel, source) {}
+
+//Validate, lay out, allocate + generate
+template <typename T>
+DatasetBatch<T>::DatasetBatch(const std::vector<BatchItem<T>>& items, std::shared_ptr<const Distribution> shape, const Parallel parallel, const Memory source):
+    items(items), block(nullptr), source(source), base(parallel.seed), shape(std::move(shape))
+{
+    if (items.empty())
+        throw std::invalid_argument("invalid batch; a batch must have at least one dataset.");
+
+    if (source == Memory::ARENA or source == Memory::MAPPED)
+        throw std::invalid_argument("invalid memory source; a batch comes from the heap or from huge pages.");
+
+    //Pad every dataset to a whole number of 'DATASET_ALIGNMENT' blocks, so each one starts aligned
+    const size_t unit = DATASET_ALIGNMENT / std::gcd(sizeof(T), DATASET_ALIGNMENT);
+    offsets.reserve(items.size() + 1);
+    offsets.push_back(0);
+
+    for(const BatchItem<T>& item : items)
+    {
+        if (item.size == 0)
+            throw std::invalid_argument("invalid size; a dataset must have at least one element.");
+
+        dataset_detail::checkRange(item.min, item.max);
+        dataset_detail::checkDistinct(item.type, item.size, item.min, item.max);
+
+        if (this->shape and (item.type == DT::PERMUTATION or item.type == DT::DISTINCT))
+            throw std::invalid_argument("invalid batch; PERMUTATION and DISTINCT datasets can't follow a distribution.");
+
+        const size_t padded = item.size + (unit - item.size % unit) % unit;
+        if (padded < item.size or padded > (std::numeric_limits<size_t>::max() / sizeof(T)) - offsets.back())
+            throw std::bad_alloc();
+
+        offsets.push_back(offsets.back() + padded);
+    }
+
+    block = static_cast<T*>(dataset_detail::allocate(offsets.back() * sizeof(T), source));
+
+    try
+    {
+        genNewData(parallel);
+    }
+    catch (...)
+    {
+        //The destructor won't run for a half-built object
+        dataset_detail::deallocate(block, offsets.back() * sizeof(T), source);
+        throw;
+    }
+}
+
+//Destructor
+template <typename T>
+DatasetBatch<T>::~DatasetBatch()
+{
+    dataset_detail::deallocate(block, offsets.back() * sizeof(T), source);
+}
+
+// ********** PRIVATE METHODS **********
+
+//Generate dataset k
+template <typename T>
+template <DT dataT>
+void DatasetBatch<T>::generate(const size_t k, const unsigned threads)
+{
+    const BatchItem<T>& item = items[k];
+    const Parallel parallel{seed(k), threads};
+
+    if constexpr (dataT == DT::PERMUTATION or dataT == DT::DISTINCT)
+    {
+        if constexpr (not dataset_detail::isReal<T>)    //(the constructor refuses floating point and distributions for these)
+            dataset_detail::genDistinctDataParallel<dataT>(block + offsets[k], item.size, item.min, item.max, parallel);
+    }
+    else if (shape)
+        dataset_detail::genShapedDataParallel<dataT>(block + offsets[k], item.size, item.min, item.max, *shape, parallel);
+    else if constexpr (dataT == DT::FEW_UNIQUE)
+        dataset_detail::genUniqueDataParallel(block + offsets[k], item.size, item.min, item.max, parallel);
+    else if constexpr (dataset_detail::isPattern(dataT))
+        dataset_detail::genPatternDataParallel<dataT>(block + offsets[k], item.size, item.min, item.max, parallel);
+    else
+        dataset_detail::genRandomDataParallel<dataT>(block + offsets[k], item.size, item.min, item.max, parallel);
+}
+
+// ********** PUBLIC METHODS **********
+
+//Regenerate every dataset
+template <typename T>
+void DatasetBatch<T>::genNewData(const Parallel parallel)
+{
+    base = parallel.seed;
+
+    const auto generateAny = [&](const size_t k, const unsigned threads)
+    {
+        if (items[k].type == DT::RANDOM)
+            generate<DT::RANDOM>(k, threads);
+        else if (items[k].type == DT::SORTED)
+            generate<DT::SORTED>(k, threads);
+        else if (items[k].type == DT::REVERSE_SORTED)
+            generate<DT::REVERSE_SORTED>(k, threads);
+        else if (items[k].type == DT::NEARLY_SORTED)
+            generate<DT::NEARLY_SORTED>(k, threads);
+        else if (items[k].type == DT::FEW_UNIQUE)
+            generate<DT::FEW_UNIQUE>(k, threads);
+        else if (items[k].type == DT::PERMUTATION)
+            generate<DT::PERMUTATION>(k, threads);
+        else if (items[k].type == DT::DISTINCT)
+            generate<DT::DISTINCT>(k, threads);
+        else if (items[k].type == DT::ORGAN_PIPE)
+            generate<DT::ORGAN_PIPE>(k, threads);
+        else if (items[k].type == DT::SAWTOOTH)
+            generate<DT::SAWTOOTH>(k, threads);
+        else if (items[k].type == DT::PUSH_FRONT)
+            generate<DT::PUSH_FRONT>(k, threads);
+        else if (items[k].type == DT::PUSH_BACK)
+            generate<DT::PUSH_BACK>(k, threads);
+        else
+            generate<DT::ALL_EQUAL>(k, threads);
+    };
+
+    //Large datasets are split between every thread, one after the other
+    std::vector<size_t> small, starts{0};
+    for(size_t k=0; k < items.size(); k++)
+    {
+        if (items[k].size >= dataset_detail::PARALLEL_GRAIN)
+            generateAny(k, parallel.threads);
+        else
+        {
+            small.push_back(k);
+            starts.push_back(starts.back() + items[k].size);
+        }
+    }
+
+    //Small ones are laid end to end and split by elements; a thread makes the datasets that start in its range, each on its own
+    dataset_detail::parallelFor(starts.back(), parallel.threads, [&](const size_t first, const size_t last)
+    {
+        for(size_t j = std::lower_bound(starts.begin(), starts.end() - 1, first) - starts.begin(); j < small.size() and starts[j] < last; j++)
+            generateAny(small[j], 1);
+    });
+}
+
+//Number of datasets
+template <typename T>
+size_t DatasetBatch<T>::size() const noexcept
+{
+    return items.size();
+}
+
+//Dataset k's seed
+template <typename T>
+std::uint64_t DatasetBatch<T>::seed(const size_t k) const noexcept
+{
+    const std::array<std::uint32_t, 4> words = Philox4x32::block(base, k, dataset_detail::STREAM_BATCH);
+    return static_cast<std::uint64_t>(words[1]) << 32 | words[0];
+}
+
+//The whole block
+template <typename T>
+T* DatasetBatch<T>::data() noexcept
+{
+    return block;
+}
+
+template <typename T>
+const T* DatasetBatch<T>::data() const noexcept
+{
+    return block;
+}
+
+// ********** OPERATOR OVERLOADING **********
+
+//Dataset k
+template <typename T>
+DatasetSpan<T> DatasetBatch<T>::operator[](const size_t k) noexcept
+{
+    return DatasetSpan<T>(block + offsets[k], items[k].size);
+}
+
+template <typename T>
+DatasetSpan<const T> DatasetBatch<T>::operator[](const size_t k) const noexcept
+{
+    return DatasetSpan<const T>(block + offsets[k], items[k].size);
+}
+
+
+/*
+    +-----------------------------------+
+    |     JoinDataset Implementation    |
+    +-----------------------------------+
 */
 
-//Header guard
-#pragma once
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor: validate, lay out, allocate + generate
+template <typename K, typename P>
+JoinDataset<K, P>::JoinDataset(const Join& join, const K min, const K max, const Parallel parallel, const Memory source):
+    join(join), min(min), max(max), block(nullptr), source(source), hits(0)
+{
+    if (join.keys == 0 or join.probes == 0 or join.fanout == 0)
+        throw std::invalid_argument("invalid join; both sides need at least one row, and every key at least one build row.");
+
+    if (not (join.selectivity >= 0 and join.selectivity <= 1))
+        throw std::invalid_argument("invalid join; the selectivity must be between 0 and 1.");
+
+    if (not (join.skew >= 0) or not std::isfinite(join.skew))
+        throw std::invalid_argument("invalid join; the skew must be finite and non-negative.");
+
+    if (join.skew > 0 and join.keys > (std::uint64_t(1) << 32))
+        throw std::invalid_argument("invalid join; skewed keys are Zipf ranks, of which there are at most 2^32.");
+
+    if (source == Memory::ARENA or source == Memory::MAPPED)
+        throw std::invalid_argument("invalid memory source; a join comes from the heap or from huge pages.");
+
+    //The key table holds the build keys and, if some probes miss, as many keys again for them
+    if (join.fanout > std::numeric_limits<size_t>::max() / join.keys or join.keys > std::numeric_limits<size_t>::max() / 2)
+        throw std::bad_alloc();
+
+    dataset_detail::checkRange(min, max);
+    dataset_detail::checkDistinct(DT::DISTINCT, join.selectivity < 1 ? 2 * join.keys : join.keys, min, max);
+
+    //Every column starts on a 'DATASET_ALIGNMENT' boundary (and no column's byte count may wrap)
+    const size_t rows = join.keys * join.fanout, widest = std::max(sizeof(K), sizeof(P));
+    if (rows > std::numeric_limits<size_t>::max() / widest or join.probes > std::numeric_limits<size_t>::max() / widest)
+        throw std::bad_alloc();
+
+    const size_t bytes[4] = {rows * sizeof(K), rows * sizeof(P), join.probes * sizeof(K), join.probes * sizeof(P)};
+    offsets.push_back(0);
+
+    for(const size_t column : bytes)
+    {
+        const size_t padded = column + (DATASET_ALIGNMENT - column % DATASET_ALIGNMENT) % DATASET_ALIGNMENT;
+        if (padded < column or padded > std::numeric_limits<size_t>::max() - offsets.back())
+            throw std::bad_alloc();
+
+        offsets.push_back(offsets.back() + padded);
+    }
+
+    block = static_cast<char*>(dataset_detail::allocate(offsets.back(), source));
+
+    try
+    {
+        genNewData(parallel);
+    }
+    catch (...)
+    {
+        //The destructor won't run for a half-built object
+        dataset_detail::deallocate(block, offsets.back(), source);
+        throw;
+    }
+}
+
+//Destructor
+template <typename K, typename P>
+JoinDataset<K, P>::~JoinDataset()
+{
+    dataset_detail::deallocate(block, offsets.back(), source);
+}
+
+// ********** PRIVATE METHODS **********
+
+//Column k
+template <typename K, typename P>
+template <typename C>
+C* JoinDataset<K, P>::column(const size_t k) const noexcept
+{
+    return reinterpret_cast<C*>(block + offsets[k]);
+}
+
+// ********** PUBLIC METHODS **********
+
+//Regenerate every column
+template <typename K, typename P>
+void JoinDataset<K, P>::genNewData(const Parallel parallel)
+{
+    /*
+        JoinDataset Implementation:
+        1. Draw the key table: 'keys' different values for the build side, then (if some probes miss) 'keys' more that only the probe side uses
+        2. Build side: a random permutation of the rows decides where each key's 'fanout' rows go
+        3. Probe side: a hit draw and a key draw per row; hits take build key 'rank', misses take the rank-th key of the rest
+    */
+
+    const auto subSeed = [&](const std::uint64_t k)
+    {
+        const std::array<std::uint32_t, 4> words = Philox4x32::block(parallel.seed, k, dataset_detail::STREAM_JOIN);
+        return static_cast<std::uint64_t>(words[1]) << 32 | words[0];
+    };
+
+    //1. The key table (different values in random order, so the build keys are a random subset of the range)
+    std::vector<K> table(join.selectivity < 1 ? 2 * join.keys : join.keys);
+    dataset_detail::genDistinctDataParallel<DT::DISTINCT>(table.data(), table.size(), min, max, Parallel{subSeed(0), parallel.threads});
 
-//Native C++ Libraries
-#include <iostream>          //Input/output
-#include <iomanip>          //Formatting floats
-#include <random>          //Random number generators
-#include <algorithm>      //Sorting functions
-#include <type_traits>   //Type-info for type-guarding
-#include <stdexcept>    //Contains 'std::invalid_argument'
+    //2. Row r holds key 'order[r] / fanout': each key exactly 'fanout' times, scattered (a single row per key needs no order: the table is already random)
+    const size_t rows = join.keys * join.fanout;
+    K* const buildKey = column<K>(0);
+    P* const buildPayload = column<P>(1);
 
-//Native C Libraries
-#include <cstddef>     //Contains 'size_t'
-#include <cmath>      //Contains 'sqrt()'
+    std::vector<std::uint64_t> order(join.fanout > 1 ? rows : 0);
+    if (join.fanout > 1)
+        dataset_detail::genDistinctDataParallel<DT::PERMUTATION>(order.data(), rows, std::uint64_t(0), std::uint64_t(rows - 1), Parallel{subSeed(1), parallel.threads});
+
+    dataset_detail::parallelFor(rows, parallel.threads, [&](const size_t first, const size_t last)
+    {
+        for(size_t r=first; r < last; r++)
+        {
+            buildKey[r] = table[join.fanout > 1 ? order[r] / join.fanout : r];
+            buildPayload[r] = static_cast<P>(r);
+        }
+    });
+
+    //3. The probe side: a 32-bit hit draw below 'selectivity * 2^32' is a hit; the key draw is a Zipf rank through the alias table, or uniform
+    std::vector<dataset_detail::AliasEntry> ranks;
+    if (join.skew > 0)
+    {
+        std::vector<double> weights(join.keys);
+        for(size_t k=0; k < join.keys; k++)
+            weights[k] = std::pow(static_cast<double>(k + 1), -join.skew);
 
+        ranks = dataset_detail::aliasTable(weights);
+    }
+
+    const std::uint64_t threshold = static_cast<std::uint64_t>(std::llround(join.selectivity * 4294967296.0));
+    const bool always = threshold > std::numeric_limits<std::uint32_t>::max();     //(no draws needed)
+    K* const probeKey = column<K>(2);
+    P* const probePayload = column<P>(3);
+    std::atomic<size_t> found(0);
+
+    dataset_detail::parallelFor(join.probes, parallel.threads, [&](const size_t first, const size_t last)
+    {
+        std::uint32_t hit[dataset_detail::KERNEL_CHUNK];
+        std::uint64_t draw[dataset_detail::KERNEL_CHUNK];
+        size_t local = 0;
+
+        for(size_t done=first; done < last; done += dataset_detail::KERNEL_CHUNK)
+        {
+            const size_t amount = std::min(dataset_detail::KERNEL_CHUNK, last - done);
+            if (not always)
+                dataset_detail::fillStream<std::uint32_t>(hit, done, amount, 0, std::numeric_limits<std::uint32_t>::max(), parallel.seed, dataset_detail::subStream(dataset_detail::STREAM_JOIN, 1));
+
+            if (join.skew > 0)
+                dataset_detail::fillStream<std::uint64_t>(draw, done, amount, 0, std::numeric_limits<std::uint64_t>::max(), parallel.seed, dataset_detail::subStream(dataset_detail::STREAM_JOIN, 2));
+            else
+                dataset_detail::fillStream<std::uint64_t>(draw, done, amount, 0, join.keys - 1, parallel.seed, dataset_detail::subStream(dataset_detail::STREAM_JOIN, 2));
+
+            for(size_t k=0; k < amount; k++)
+            {
+                const size_t rank = join.skew > 0 ? dataset_detail::aliasPick(ranks, draw[k]) : static_cast<size_t>(draw[k]);
+                const bool match = always or hit[k] < threshold;
 
-//Different types of datasets (as an enum class for type safety)
-enum class DT { RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED, FEW_UNIQUE };
+                probeKey[done + k] = table[match ? rank : join.keys + rank];
+                probePayload[done + k] = static_cast<P>(done + k);
+                local += match;
+            }
+        }
+
+        found += local;
+    });
 
+    hits = found;
+}
 
-//Dataset class contains a smart pointer to an array of random numeric values
-template <typename T, size_t size, DT dataT = DT::RANDOM>  //Default distribution is 'RANDOM' (generic random dataset)
-class Dataset
+//Rows of the equi-join
+template <typename K, typename P>
+size_t JoinDataset<K, P>::matches() const noexcept
 {
-    //Guarding against non-numeric types
-    static_assert(std::is_integral<T>::value, "Dataset class can only be of an integral type (int, unsigned int, short...etc)");
-    static_assert(not std::is_same<char, T>::value and not std::is_same<wchar_t, T>::value, "Dataset objects must be integral, not character");
+    return hits * join.fanout;
+}
+
+//Build side: keys
+template <typename K, typename P>
+DatasetSpan<K> JoinDataset<K, P>::buildKeys() noexcept
+{
+    return DatasetSpan<K>(column<K>(0), join.keys * join.fanout);
+}
 
+//Build side: payloads
+template <typename K, typename P>
+DatasetSpan<P> JoinDataset<K, P>::buildPayloads() noexcept
+{
+    return DatasetSpan<P>(column<P>(1), join.keys * join.fanout);
+}
 
-    // DATA MEMBERS //
-    private:
-        T dataset[size];                //Internal array
+//Probe side: keys
+template <typename K, typename P>
+DatasetSpan<K> JoinDataset<K, P>::probeKeys() noexcept
+{
+    return DatasetSpan<K>(column<K>(2), join.probes);
+}
 
-    public:
-        const size_t length;   //const!
+//Probe side: payloads
+template <typename K, typename P>
+DatasetSpan<P> JoinDataset<K, P>::probePayloads() noexcept
+{
+    return DatasetSpan<P>(column<P>(3), join.probes);
+}
 
-    // FUNCTION MEMBERS //
-    private:
-        void genRandomData(const T, const T);        //Generate a new dataset, which is sorted if needed
-        void genUniqueData(const T, const T);       //Generate a new dataset of few-unique data
+template <typename K, typename P>
+DatasetSpan<const K> JoinDataset<K, P>::buildKeys() const noexcept
+{
+    return DatasetSpan<const K>(column<const K>(0), join.keys * join.fanout);
+}
 
-    public:
-        //Public special methods
-        constexpr Dataset(const T = 0, const T = 1000);   //default minimum, maximum
+template <typename K, typename P>
+DatasetSpan<const P> JoinDataset<K, P>::buildPayloads() const noexcept
+{
+    return DatasetSpan<const P>(column<const P>(1), join.keys * join.fanout);
+}
 
-        //Public methods
-        void genNewData(const T = 0, const T = 1000);    //Helper function: generates a new dataset of the appropriate type (RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED, FEW_UNIQUE)
-        void print() const;                             //Prints the array
-        constexpr T* get() const noexcept;             //Return a pointer to the internal array
+template <typename K, typename P>
+DatasetSpan<const K> JoinDataset<K, P>::probeKeys() const noexcept
+{
+    return DatasetSpan<const K>(column<const K>(2), join.probes);
+}
 
-        //Iterators
-        constexpr T* begin() const noexcept;              //Beginning of the array
-        constexpr T* end() const noexcept;               //End of the array
+template <typename K, typename P>
+DatasetSpan<const P> JoinDataset<K, P>::probePayloads() const noexcept
+{
+    return DatasetSpan<const P>(column<const P>(3), join.probes);
+}
 
-        //Operator overloads
-        operator T*();             //Implicit conversion to pointer (for passing to T[])
-        T& operator[](size_t);    //[] Overload for accessing class like 'arr[5] = ...'
-};
 
 /*
-    +----------------------------+
-    |   Dataset Implementation   |
-    +----------------------------+
+    +-----------------------------------+
+    |    RecordDataset Implementation   |
+    +-----------------------------------+
 */
 
-
 // ********** SPECIAL MEMBER FUNCTIONS **********
 
-//Constructor
-template <typename T, size_t size, DT dataT>
-constexpr Dataset<T, size, dataT>::Dataset(const T min, const T max): length(size)   //Initializer list for const data member
+//Constructor: allocate + generate
+template <typename K, size_t bytes, DT dataT, Layout layout>
+RecordDataset<K, bytes, dataT, layout>::RecordDataset(const size_t size, const K min, const K max, const Parallel parallel, const Payload payload, const Memory source):
+    block(nullptr), source(source), split(0), total(0), payload(payload), length(size)
 {
-    if (max < min)
-        throw std::invalid_argument("invalid range; maximum cannnot be less than the minimum.");
+    if (size == 0)
+        throw std::invalid_argument("invalid size; a dataset must have at least one element.");
 
-    //Generate new data (random, sorted, reverse-sorted, nearly-sorted, or few-unique)
-    genNewData(max, min);
+    if (source == Memory::ARENA or source == Memory::MAPPED)
+        throw std::invalid_argument("invalid memory source; records come from the heap or from huge pages.");
+
+    if (size > std::numeric_limits<size_t>::max() / bytes - 1)
+        throw std::bad_alloc();
+
+    //SOA: the payload column starts on a 'DATASET_ALIGNMENT' boundary after the keys
+    split = layout == Layout::SOA ? (size * sizeof(K) + DATASET_ALIGNMENT - 1) / DATASET_ALIGNMENT * DATASET_ALIGNMENT : 0;
+    total = layout == Layout::SOA ? split + size * payloadBytes : size * bytes;
+    block = static_cast<char*>(dataset_detail::allocate(total, source));
+
+    try
+    {
+        genNewData(min, max, parallel);
+    }
+    catch (...)
+    {
+        //The destructor won't run for a half-built object
+        dataset_detail::deallocate(block, total, source);
+        throw;
+    }
 }
 
-// ********** PRIVATE METHODS ********** //
+//Destructor
+template <typename K, size_t bytes, DT dataT, Layout layout>
+RecordDataset<K, bytes, dataT, layout>::~RecordDataset()
+{
+    dataset_detail::deallocate(block, total, source);
+}
+
+// ********** PUBLIC METHODS **********
 
-//Generate random data (for: RANDOM, SORTED, REVERSE_SORTED)
-template <typename T, size_t size, DT dataT>
-void Dataset<T, size, dataT>::genRandomData(const T min, const T max)
+//Regenerate every key and payload
+template <typename K, size_t bytes, DT dataT, Layout layout>
+void RecordDataset<K, bytes, dataT, layout>::genNewData(const K min, const K max, const Parallel parallel)
 {
-    if (max < min)
-        throw std::invalid_argument("invalid range; maximum cannnot be less than the minimum.");
+    /*
+        RecordDataset Implementation:
+        1. Every worker takes a copy of one producer of the keys (the copies share its views) and a range of the records
+        2. A chunk of the range at a time (a few hundred KB of records): the keys are computed straight into the key column (SOA) or a staging buffer,
+           the random payload bytes are one slice of the payload stream
+        3. AOS: the keys and payloads are copied into the records while they are all still in cache
+    */
 
-    //Create + seed Mersenne Twister random number generator
-    std::random_device rd;
-    std::mt19937 RNG(rd());
+    const DatasetProducer<K, dataT> producer(length, min, max, parallel.seed);
+    const size_t chunk = std::max<size_t>(1, dataset_detail::PRODUCER_BLOCK / bytes);
 
-    //Apply distribution
-    std::uniform_int_distribution<T> distribution(min, max);   // TODO: allow for float/double overload via 'if constexpr' conditional compilation
+    dataset_detail::parallelFor(length, parallel.threads, [&](const size_t first, const size_t last)
+    {
+        DatasetProducer<K, dataT> own = producer;
+        std::vector<K> staged(layout == Layout::AOS ? std::min(chunk, last - first) : 0);
+        std::vector<std::uint32_t> words(payload == Payload::RANDOM ? (std::min(chunk, last - first) * payloadBytes + 7) / 4 : 0);
 
-    //Fill the array with random values
-    for(size_t i=0; i < size; i++)
+        for(size_t done=first; done < last; done += chunk)
+        {
+            const size_t amount = std::min(chunk, last - done);
+            K* const keys = layout == Layout::SOA ? reinterpret_cast<K*>(block) + done : staged.data();
+            own.fill(keys, done, amount);
+
+            //Payload bytes [done * payloadBytes, (done + amount) * payloadBytes) of the stream, from the words that cover them
+            const unsigned char* random = nullptr;
+            if (payload == Payload::RANDOM)
+            {
+                const std::uint64_t start = static_cast<std::uint64_t>(done) * payloadBytes;
+                const size_t count = static_cast<size_t>((start + amount * payloadBytes + 3) / 4 - start / 4);
+                dataset_detail::fillStream<std::uint32_t>(words.data(), start / 4, count, 0, std::numeric_limits<std::uint32_t>::max(), parallel.seed, dataset_detail::STREAM_PAYLOAD);
+                random = reinterpret_cast<const unsigned char*>(words.data()) + start % 4;
+            }
+
+            for(size_t k=0; k < amount; k++)
+            {
+                unsigned char* const target = layout == Layout::SOA ? reinterpret_cast<unsigned char*>(block + split) + (done + k) * payloadBytes
+                                                                    : reinterpret_cast<record_type*>(block)[done + k].payload;
+                if (random)
+                    std::memcpy(target, random + k * payloadBytes, payloadBytes);
+                else
+                    std::memset(target, static_cast<unsigned char>(done + k), payloadBytes);
+
+                if constexpr (layout == Layout::AOS)
+                    reinterpret_cast<record_type*>(block)[done + k].key = keys[k];
+            }
+        }
+    });
+}
+
+//Number of records
+template <typename K, size_t bytes, DT dataT, Layout layout>
+size_t RecordDataset<K, bytes, dataT, layout>::size() const noexcept
+{
+    return length;
+}
+
+//AOS: the records
+template <typename K, size_t bytes, DT dataT, Layout layout>
+DatasetSpan<typename RecordDataset<K, bytes, dataT, layout>::record_type> RecordDataset<K, bytes, dataT, layout>::records() noexcept
+{
+    static_assert(layout == Layout::AOS, "only an AOS dataset has records; an SOA one has 'keys()' and 'payloads()'");
+    return DatasetSpan<record_type>(reinterpret_cast<record_type*>(block), length);
+}
+
+//SOA: the keys
+template <typename K, size_t bytes, DT dataT, Layout layout>
+DatasetSpan<K> RecordDataset<K, bytes, dataT, layout>::keys() noexcept
+{
+    static_assert(layout == Layout::SOA, "only an SOA dataset has a key column; an AOS one has 'records()'");
+    return DatasetSpan<K>(reinterpret_cast<K*>(block), length);
+}
+
+//SOA: the payloads
+template <typename K, size_t bytes, DT dataT, Layout layout>
+DatasetSpan<unsigned char> RecordDataset<K, bytes, dataT, layout>::payloads() noexcept
+{
+    static_assert(layout == Layout::SOA, "only an SOA dataset has a payload column; an AOS one has 'records()'");
+    return DatasetSpan<unsigned char>(reinterpret_cast<unsigned char*>(block + split), length * payloadBytes);
+}
+
+template <typename K, size_t bytes, DT dataT, Layout layout>
+DatasetSpan<const typename RecordDataset<K, bytes, dataT, layout>::record_type> RecordDataset<K, bytes, dataT, layout>::records() const noexcept
+{
+    static_assert(layout == Layout::AOS, "only an AOS dataset has records; an SOA one has 'keys()' and 'payloads()'");
+    return DatasetSpan<const record_type>(reinterpret_cast<const record_type*>(block), length);
+}
+
+template <typename K, size_t bytes, DT dataT, Layout layout>
+DatasetSpan<const K> RecordDataset<K, bytes, dataT, layout>::keys() const noexcept
+{
+    static_assert(layout == Layout::SOA, "only an SOA dataset has a key column; an AOS one has 'records()'");
+    return DatasetSpan<const K>(reinterpret_cast<const K*>(block), length);
+}
+
+template <typename K, size_t bytes, DT dataT, Layout layout>
+DatasetSpan<const unsigned char> RecordDataset<K, bytes, dataT, layout>::payloads() const noexcept
+{
+    static_assert(layout == Layout::SOA, "only an SOA dataset has a payload column; an AOS one has 'records()'");
+    return DatasetSpan<const unsigned char>(reinterpret_cast<const unsigned char*>(block + split), length * payloadBytes);
+}
+
+
+/*
+    +-----------------------------------+
+    |   DatasetPipeline Implementation  |
+    +-----------------------------------+
+*/
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor: the ring starts full (datasets 0 to buffers - 1), then the workers start
+template <typename T, DT dataT>
+DatasetPipeline<T, dataT>::DatasetPipeline(const size_t size, const T min, const T max, const Parallel parallel, const Prefetch& settings):
+    min(min), max(max), parallel(parallel), settings(settings), given(0), returned(0), claimed(0), stopping(false)
+{
+    if (settings.buffers == 0 or settings.workers == 0 or settings.repeats == 0)
+        throw std::invalid_argument("invalid prefetch settings; a pipeline needs at least one buffer, one worker and one use of every seed.");
+
+    //No more buffers than datasets
+    const size_t buffers = settings.total != 0 ? std::min(settings.buffers, settings.total) : settings.buffers;
+    this->settings.buffers = buffers;
+
+    ring.reserve(buffers);
+    for(size_t k=0; k < buffers; k++)
+        ring.emplace_back(size, min, max, Parallel{seed(k), parallel.threads});
+
+    sequence.resize(buffers);
+    std::iota(sequence.begin(), sequence.end(), size_t(0));
+    ready.assign(buffers, 1);
+    errors.resize(buffers);
+    claimed = buffers;
+
+    try
     {
-        //Generate a random value between the minimum and maximum
-        dataset[i] = distribution(RNG);
+        for(unsigned w=0; w < settings.workers; w++)
+            workers.emplace_back(&DatasetPipeline::work, this);
     }
-
-    //Sort?
-    if constexpr (dataT == DT::SORTED or dataT == DT::NEARLY_SORTED)
+    catch (...)
     {
-        //Sort in non-decreasing order (0 -> 1000, with repeats)
-        std::sort(dataset, dataset + length, [](size_t i, size_t j) {return i < j;});  //lambda expression
+        //Couldn't start every worker: stop the ones that did start
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        refill.notify_all();
+        for(std::thread& worker : workers)
+            worker.join();
+        throw;
     }
+}
 
-    //Reverse sort?
-    if constexpr (dataT == DT::REVERSE_SORTED)
+//Destructor
+template <typename T, DT dataT>
+DatasetPipeline<T, dataT>::~DatasetPipeline()
+{
     {
-        //Sort in non-increasing order (1000 -> 0, with repeats)
-        std::sort(dataset, dataset + length, [](size_t i, size_t j) {return i > j;});  //lambda expression
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
     }
+    refill.notify_all();
+
+    for(std::thread& worker : workers)
+        worker.join();
+}
+
+// ********** PRIVATE METHODS **********
+
+//Worker loop
+template <typename T, DT dataT>
+void DatasetPipeline<T, dataT>::work()
+{
+    std::unique_lock<std::mutex> guard(lock);
 
-    //Nearly sorted? 
-    if constexpr (dataT == DT::NEARLY_SORTED)
+    for(;;)
     {
-        //Mess up the order :D! (just a bit)
-        std::uniform_int_distribution<T> randomIndex(0, size-1);      //Random index generator 
-        size_t amount = sqrt(sqrt(size));   
+        //Dataset 'claimed' goes in the slot of dataset 'claimed - buffers', once that one is handed back
+        refill.wait(guard, [&]() { return stopping or (claimed < returned + settings.buffers and (settings.total == 0 or claimed < settings.total)); });
+        if (stopping)
+            return;
 
-        for(size_t i=0; i < amount; i++)
+        const size_t k = claimed++, slot = k % settings.buffers;
+        sequence[slot] = k;
+        ready[slot] = 0;
+
+        //Generated outside the lock, so the consumer and the other workers carry on
+        guard.unlock();
+        std::exception_ptr error;
+        try
+        {
+            ring[slot].genNewData(min, max, Parallel{seed(k), parallel.threads});
+        }
+        catch (...)
         {
-           //Swap two random element
-           std::swap(dataset[randomIndex(RNG)], dataset[randomIndex(RNG)]);
+            error = std::current_exception();
         }
+        guard.lock();
+
+        ready[slot] = 1;
+        errors[slot] = error;
+        filled.notify_all();
     }
 }
 
-//Generate few-unique data (for: FEW_UNIQUE)
-template <typename T, size_t size, DT dataT>
-void Dataset<T, size, dataT>::genUniqueData(const T min, const T max)
+// ********** PUBLIC METHODS **********
+
+//Hand back the previous dataset, then wait for the next one
+template <typename T, DT dataT>
+DynamicDataset<T, dataT>& DatasetPipeline<T, dataT>::next()
 {
-    if (max < min)
-        throw std::invalid_argument("invalid range; maximum cannnot be less than the minimum.");
+    std::unique_lock<std::mutex> guard(lock);
 
-    //Create + seed Mersenne Twister random number generator
-    std::random_device rd;
-    std::mt19937 RNG(rd());
+    if (settings.total != 0 and given == settings.total)
+        throw std::out_of_range("invalid call; every dataset of the pipeline ('Prefetch::total') has been given out.");
 
-    //Apply distribution
-    std::uniform_int_distribution<T> distribution(min, max);   // TODO: allow for float/double overload via 'if constexpr' conditional compilation
+    if (returned < given)
+    {
+        returned = given;
+        refill.notify_all();
+    }
 
-    /*
-        FEW_UNIQUE Implementation:
-        1. Fill the beginning of the array with {sqrt(size)} random elements
-        2. Use the filled slots to randomly fill the rest of the dataset
-        3. Remove the unique subset at the beginning of the array (the initial random elements) 
-    */
+    const size_t slot = given % settings.buffers;
+    filled.wait(guard, [&]() { return sequence[slot] == given and ready[slot]; });
 
+    if (errors[slot])
+        std::rethrow_exception(errors[slot]);
+
+    ready[slot] = 0;
+    given++;
+    return ring[slot];
+}
+
+//Number of the dataset given out last
+template <typename T, DT dataT>
+size_t DatasetPipeline<T, dataT>::position() const noexcept
+{
+    return given - 1;
+}
+
+//Dataset k's seed
+template <typename T, DT dataT>
+std::uint64_t DatasetPipeline<T, dataT>::seed(const size_t k) const noexcept
+{
+    return parallel.seed + k / settings.repeats;
+}
 
-    //The amount of unique elements is the square root of the size of the dataset
-    size_t amount = sqrt(size);       //Still using 'size_t' because the square root of 18.422 quintillion is still larger than max size of an int 
-    size_t i = 0;                    //The iterator 'i' delcare outside so it can span both loops
 
-    //Apply random distributions
-    std::uniform_int_distribution<T> randomSampleIndex(0, amount-1);   //Generate a random element of the sample list to draw from
-    std::uniform_int_distribution<T> randomIndex(0, size-1);          //Generate a random index in the array
+/*
+    +-----------------------------------+
+    |     Validators Implementation     |
+    +-----------------------------------+
+*/
 
-    //Populate the sample list with a few random values
-    for(i; i < amount; i++)
+// ********** INTERNALS **********
+
+//An element's hash: its bits as one word, or as two (128-bit integers; extended precision as the two doubles that add up to it, so padding never counts)
+template <typename T>
+std::uint64_t dataset_detail::elementHash(const T value) noexcept
+{
+    if constexpr (isReal<T> and sizeof(T) > sizeof(double))
+    {
+        const double high = static_cast<double>(value), low = static_cast<double>(value - static_cast<T>(high));
+        return mixValue(elementHash(low) ^ elementHash(high));
+    }
+    else if constexpr (sizeof(T) > sizeof(std::uint64_t))
+    {
+        const auto bits = static_cast<typename unsignedOf<T>::type>(value);
+        return mixValue(static_cast<std::uint64_t>(bits) ^ mixValue(static_cast<std::uint64_t>(bits >> 64)));
+    }
+    else
     {
-        //Generate a random value
-        dataset[i] = distribution(RNG);
+        //(zero-extended, so a 32-bit element hashes like the bulk kernel's 32-bit words)
+        typename std::conditional<sizeof(T) <= 4, std::uint32_t, std::uint64_t>::type bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        return mixValue(bits);
     }
+}
 
-    //Use the random sample to propagate the rest of the data
-    for(i; i < size; i++)  
+//Sum of the elements' hashes
+template <typename T>
+std::uint64_t dataset_detail::hashSum(const T* data, const size_t count) noexcept
+{
+    if constexpr (sizeof(T) == 4 or sizeof(T) == 8)
+        return hashSumKernel()(data, count, sizeof(T));
+    else
     {
-        //Generate a random value from the sample set
-        dataset[i] = dataset[randomSampleIndex(RNG)];
+        std::uint64_t sum = 0;
+        for(size_t i=0; i < count; i++)
+            sum += elementHash(data[i]);
+
+        return sum;
     }
+}
 
+//Non-decreasing order
+template <typename T>
+bool dataset_detail::sortedRange(const T* data, const size_t count) noexcept
+{
+    //'BLOCK' comparisons at a time, OR-ed together without a branch, then one test per block
+    constexpr size_t BLOCK = 64;
+    size_t i = 1;
 
-    //Eliminate the unique subset at the beginning of the array (the sample list from the 1st for-loop)
-    for(int j=0; j < amount; j++)
+    for(; i + BLOCK <= count; i += BLOCK)
     {
-        //Swap the current element from the sample list with a random element
-        std::swap(dataset[j], dataset[randomIndex(RNG)]);
+        bool descent = false;
+
+        #pragma GCC unroll 64
+        for(size_t k=0; k < BLOCK; k++)
+            descent |= data[i + k] < data[i + k - 1];
+
+        if (descent)
+            return false;
     }
+
+    for(; i < count; i++)
+        if (data[i] < data[i - 1])
+            return false;
+
+    return true;
 }
 
+//The first element and length of a contiguous range
+template <typename Range>
+std::pair<const dataset_detail::elementOf<Range>*, size_t> dataset_detail::contiguous(const Range& range)
+{
+    const auto first = std::begin(range), last = std::end(range);
+    const size_t count = static_cast<size_t>(last - first);
+    return {count > 0 ? &*first : nullptr, count};
+}
 
-// ********** PUBLIC METHODS **********
+// ********** VALIDATORS **********
 
-//Generate a new dataset
-template <typename T, size_t size, DT dataT>
-void Dataset<T, size, dataT>::genNewData(const T min, const T max)
+//Non-decreasing order: every worker checks its part, and the step from its last element to the next part's first
+template <typename Range>
+bool isSorted(const Range& range, const unsigned threads)
 {
-    if constexpr (dataT == DT::FEW_UNIQUE)
-        genUniqueData(max, min);
-    else
-        genRandomData(max, min);  //sorting is automatically taken care of here
+    const auto elements = dataset_detail::contiguous(range);
+    std::atomic<bool> sorted(true);
+
+    dataset_detail::parallelFor(elements.second, threads, [&](const size_t first, const size_t last)
+    {
+        if (not dataset_detail::sortedRange(elements.first + first, std::min(last + 1, elements.second) - first))
+            sorted = false;
+    });
 
+    return sorted;
 }
 
-//Return a pointer to the array (not really necessary because of implicit T* conversion)
-template <typename T, size_t size, DT dataT>
-constexpr T* Dataset<T, size, dataT>::get() const noexcept
+//Order-independent checksum: partial sums of any split add up to the same total
+template <typename Range>
+std::uint64_t multisetChecksum(const Range& range, const unsigned threads)
 {
-    //Return a pointer to the internal array
-    return &dataset[0];
+    const auto elements = dataset_detail::contiguous(range);
+    std::atomic<std::uint64_t> sum(0);
+
+    dataset_detail::parallelFor(elements.second, threads, [&](const size_t first, const size_t last)
+    {
+        sum += dataset_detail::hashSum(elements.first + first, last - first);
+    });
+
+    return sum;
 }
 
-//Print
-template <typename T, size_t size, DT dataT>
-void Dataset<T, size, dataT>::print() const
+//Every different value and its count: each worker sorts a copy of its part and counts the runs, then the workers' counts are merged
+template <typename Range>
+std::vector<std::pair<dataset_detail::elementOf<Range>, size_t>> histogram(const Range& range, const unsigned threads)
 {
-    //Print all the values of the array
-    for(size_t i=0; i < size; i++)
+    using T = dataset_detail::elementOf<Range>;
+    const auto elements = dataset_detail::contiguous(range);
+
+    std::vector<std::pair<T, size_t>> counts;
+    std::mutex lock;
+
+    dataset_detail::parallelFor(elements.second, threads, [&](const size_t first, const size_t last)
+    {
+        std::vector<T> sorted(elements.first + first, elements.first + last);
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<std::pair<T, size_t>> runs;
+        for(size_t i=0; i < sorted.size(); )
+        {
+            const size_t end = static_cast<size_t>(std::upper_bound(sorted.begin() + i, sorted.end(), sorted[i]) - sorted.begin());
+            runs.emplace_back(sorted[i], end - i);
+            i = end;
+        }
+
+        const std::lock_guard<std::mutex> guard(lock);
+        counts.insert(counts.end(), runs.begin(), runs.end());
+    });
+
+    //A value several workers saw appears once per worker: sort by value and add those up
+    std::sort(counts.begin(), counts.end(), [](const std::pair<T, size_t>& a, const std::pair<T, size_t>& b) { return a.first < b.first; });
+
+    std::vector<std::pair<T, size_t>> merged;
+    for(const std::pair<T, size_t>& entry : counts)
     {
-        std::cout << dataset[i] << " ";
+        if (not merged.empty() and not (merged.back().first < entry.first))
+            merged.back().second += entry.second;
+        else
+            merged.push_back(entry);
     }
-    std::cout << std::endl;
+
+    return merged;
 }
 
 
-// ********** ITERATORS ********** 
+#if defined(DATASET_POSIX_IO)
 
-//Begin iterator
-template <typename T, size_t size, DT dataT>
-constexpr T* Dataset<T, size, dataT>::begin() const noexcept
+/*
+    +-----------------------------------+
+    |    PackedReader Implementation    |
+    +-----------------------------------+
+*/
+
+// ********** PUBLIC SPECIAL METHODS **********
+
+template <typename T>
+PackedReader<T>::PackedReader(const std::string& file) : path(file), mapping(nullptr), bytes(0), elements(0), block(0), current(nullptr), next(0)
 {
-    //Return the address of the first element in the array
-    return &dataset[0];
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::system_error(errno, std::generic_category(), "cannot open '" + path + "' for reading");
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "cannot read '" + path + "'");
+    }
+
+    bytes = static_cast<size_t>(info.st_size);
+    void* mapped = bytes >= sizeof(dataset_detail::PackedHeader) ? mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    const int error = errno;
+    close(fd);
+
+    if (mapped == MAP_FAILED)
+    {
+        if (bytes < sizeof(dataset_detail::PackedHeader))
+            throw std::invalid_argument("invalid file; '" + path + "' is too short to be a packed dataset.");
+        throw std::system_error(error, std::generic_category(), "cannot map '" + path + "'");
+    }
+
+    mapping = static_cast<char*>(mapped);
+    madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+    //The header must be a packed file's, of this element type
+    dataset_detail::PackedHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    const std::uint32_t type = static_cast<std::uint32_t>(sizeof(T) | dataset_detail::isSigned<T> << 8 | dataset_detail::isReal<T> << 9);
+
+    if (std::memcmp(header.magic, "DSPACKED", 8) != 0 or header.version != dataset_detail::PACKED_VERSION or header.type != type
+        or header.block == 0 or header.block % dataset_detail::PACKED_LANES != 0 or header.block > 0xFFFFFFFF)
+    {
+        munmap(mapping, bytes);
+        throw std::invalid_argument("invalid file; '" + path + "' is not a packed dataset of this element type.");
+    }
+
+    elements = header.size;
+    block = header.block;
+    codes.resize(block);
+    rewind();
 }
 
+template <typename T>
+PackedReader<T>::~PackedReader()
+{
+    munmap(mapping, bytes);
+}
 
-//End iterator
-template <typename T, size_t size, DT dataT>
-constexpr T* Dataset<T, size, dataT>::end() const noexcept
-{                            
-    //Return the address of the last element in the array          
-    return &dataset[0] + length;
+// ********** PUBLIC METHODS **********
+
+template <typename T>
+size_t PackedReader<T>::nextBlock(T* out)
+{
+    if (next == elements)
+        return 0;
+
+    const size_t count = std::min(block, elements - next);
+    const char* following = dataset_detail::unpackBlock(current, mapping + bytes, out, codes);
+
+    //Every block but the last holds exactly 'block' elements
+    dataset_detail::PackedBlock header;
+    std::memcpy(&header, current, sizeof(header));
+    if (header.count != count)
+        throw std::invalid_argument("invalid file; a block of '" + path + "' holds the wrong number of elements.");
+
+    current = following;
+    next += count;
+    return count;
 }
 
-// ********** OPERATOR OVERLOADING **********
+//Walk the block headers once (a few bytes each), then decode the blocks that start in each worker's range
+template <typename T>
+void PackedReader<T>::read(T* out, const unsigned threads)
+{
+    const char* end = mapping + bytes;
+    std::vector<const char*> blocks;
+    blocks.reserve((elements + block - 1) / block);
 
-//T* Conversion Overload (returns a pointer to the internal array of type T)
-template <typename T, size_t size, DT dataT>
-Dataset<T, size, dataT>::operator T*()
+    const char* at = mapping + sizeof(dataset_detail::PackedHeader);
+    for(size_t first=0; first < elements; first += block)
+    {
+        dataset_detail::PackedBlock header;
+        if (static_cast<size_t>(end - at) < sizeof(header))
+            throw std::invalid_argument("invalid file; '" + path + "' is cut short.");
+
+        std::memcpy(&header, at, sizeof(header));
+        if (header.count != std::min(block, elements - first) or header.bytes > static_cast<size_t>(end - at) - sizeof(header))
+            throw std::invalid_argument("invalid file; a block of '" + path + "' holds the wrong number of elements.");
+
+        blocks.push_back(at);
+        at += sizeof(header) + header.bytes;
+    }
+
+    //Split by elements (so small files stay on one thread), each worker taking the blocks that start in its range
+    std::vector<std::exception_ptr> errors(blocks.size());
+    dataset_detail::parallelFor(elements, threads, [&](const size_t first, const size_t last)
+    {
+        std::vector<std::uint32_t> local(block);
+        for(size_t b=(first + block - 1) / block; b * block < last; b++)
+        {
+            try
+            {
+                dataset_detail::unpackBlock(blocks[b], end, out + b * block, local);
+            }
+            catch (...)
+            {
+                errors[b] = std::current_exception();
+            }
+        }
+    });
+
+    for(const std::exception_ptr& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+template <typename T>
+void PackedReader<T>::rewind() noexcept
 {
-    //The name of the array is a pointer to the first element
-    return dataset;
+    current = mapping + sizeof(dataset_detail::PackedHeader);
+    next = 0;
 }
 
-//[] Overload
-template <typename T, size_t size, DT dataT>
-T& Dataset<T, size, dataT>::operator[](const size_t index)
+template <typename T>
+size_t PackedReader<T>::size() const noexcept
+{
+    return elements;
+}
+
+template <typename T>
+size_t PackedReader<T>::blockSize() const noexcept
 {
-    return dataset[index];
+    return block;
 }
+
+template <typename T>
+size_t PackedReader<T>::position() const noexcept
+{
+    return next;
+}
+
+#endif
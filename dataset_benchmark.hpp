@@ -0,0 +1,444 @@
+/*
+  Version: C++17
+  Compilation Instructions: Header file (includes 'dataset.hpp'). N/A.
+  Function: times user functions (sorts, searches...) on datasets of every size, distribution type and value range of a sweep
+
+  Usage examples:
+  ===============
+  'Benchmark<int> bench' sweeps the default sizes (1K, 100K, 1M), every DT and the range [0, 1000], on 5 seeds
+  'bench.run("std::sort", [](int* data, size_t n) { std::sort(data, data + n); })' times std::sort on every input of the sweep
+  'bench.print()' prints a table of the results; 'bench.writeCSV(file)' and 'bench.writeJSON(file)' export them
+*/
+
+//Header guard
+#pragma once
+
+//Datasets
+#include "dataset.hpp"
+
+//Native C++ Libraries
+#include <chrono>     //Wall-clock timing
+#include <ostream>   //Reports
+
+//Time-stamp counter
+#if (defined(__x86_64__) or defined(__i386__)) and (defined(__GNUC__) or defined(__clang__))
+#define DATASET_BENCHMARK_TSC 1
+#include <x86intrin.h>   //Contains '__rdtsc()'
+#endif
+
+
+//What a 'Benchmark' measures: every size x DT x range, each on several seeds (so the spread between inputs of one configuration is known)
+template <typename T>
+struct Sweep
+{
+    std::vector<size_t> sizes = {1000, 100000, 1000000};      //Elements per input
+    std::vector<DT> types = {DT::RANDOM, DT::SORTED, DT::REVERSE_SORTED, DT::NEARLY_SORTED, DT::FEW_UNIQUE};
+    std::vector<std::pair<T, T>> ranges = {{0, 1000}};      //(minimum, maximum) pairs
+    size_t seeds = 5;                                      //Inputs per configuration
+    size_t repetitions = 3;                               //Timed runs per input (the fastest counts; the input is restored before each)
+    std::uint64_t seed = 1;                              //Seed of the first input (input s uses seed + s)
+    unsigned threads = 0;                               //Threads that generate the inputs (0 = all cores; never during a timed run, unless prefetching)
+    size_t prefetch = 0;                               //Inputs a background thread generates ahead while the function runs (0 = none: nothing competes with a timed run)
+    bool validate = false;                            //Check (untimed) that every run left its input sorted and a permutation of what it was (sorting functions only)
+#if defined(DATASET_POSIX_IO)
+    std::string cache = "";                           //Map the inputs from this 'Cache' directory (empty = regenerate them in place)
+#endif
+};
+
+//One line of a benchmark report: a function on one configuration of the sweep
+template <typename T>
+struct BenchmarkResult
+{
+    std::string name;               //Function
+    size_t size;                   //Elements per input
+    DT type;                      //Distribution type of the inputs
+    T min, max;                  //Range of the inputs
+    size_t seeds;               //Inputs measured
+    double nsPerElement;       //Mean over the inputs (of each input's fastest run)
+    double deviation;         //Standard deviation over the inputs (ns per element)
+    double cyclesPerElement; //Mean time-stamp counter ticks per element (0 where there is no counter)
+    double elementsPerSecond;   //Throughput at the mean time
+    double bytesPerSecond;     //Throughput at the mean time, in bytes of input
+};
+
+//Keeps the compiler from discarding a value (or the work that produced it)
+template <typename V>
+void doNotOptimize(const V&) noexcept;
+
+
+/*
+    +----------------------------+
+    |         Benchmark          |
+    +----------------------------+
+*/
+
+//Benchmark times a function 'function(T* data, size_t size)' on datasets: every input is regenerated (or copied from the cache) outside the timed
+//region, so only the function is measured. Results accumulate over 'run()' calls, so several functions end up in one report
+template <typename T>
+class Benchmark
+{
+    // DATA MEMBERS //
+    private:
+        Sweep<T> sweep;                               //Default sweep of 'run()'
+        std::vector<BenchmarkResult<T>> results;     //Every configuration measured so far
+
+    // FUNCTION MEMBERS //
+    private:
+        template <DT dataT, typename Function>
+        void measure(const std::string&, Function&, const Sweep<T>&, const size_t, const T, const T);    //One configuration, on every seed
+
+    public:
+        //Public special methods
+        explicit Benchmark(const Sweep<T>& = Sweep<T>());     //default sweep
+
+        //Public methods
+        template <typename Function>
+        void run(const std::string&, Function);                         //Time a function on every input of the sweep
+        template <typename Function>
+        void run(const std::string&, Function, const Sweep<T>&);       //Time a function on every input of another sweep
+        const std::vector<BenchmarkResult<T>>& report() const noexcept;    //The results so far
+        void print(std::ostream& = std::cout) const;                     //Table of the results
+        void writeCSV(std::ostream&) const;                             //One row per result
+        void writeJSON(std::ostream&) const;                           //{"benchmarks": [...]}, one object per result
+};
+
+
+/*
+    +----------------------------+
+    |    Benchmark Internals     |
+    +----------------------------+
+*/
+
+//Implementation details of the benchmark harness (not part of the public interface)
+namespace dataset_detail
+{
+    std::uint64_t ticks() noexcept;            //Time-stamp counter (0 where there is none)
+    const char* typeName(const DT) noexcept;  //"RANDOM", "SORTED"...
+
+    template <typename T>
+    std::string valueText(const T);         //A value as text (128-bit integers included)
+
+    std::string jsonText(const std::string&);    //A string as a JSON string literal
+}
+
+//Time-stamp counter
+inline std::uint64_t dataset_detail::ticks() noexcept
+{
+#if defined(DATASET_BENCHMARK_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//Names of the distribution types
+inline const char* dataset_detail::typeName(const DT type) noexcept
+{
+    switch (type)
+    {
+        case DT::RANDOM:         return "RANDOM";
+        case DT::SORTED:         return "SORTED";
+        case DT::REVERSE_SORTED: return "REVERSE_SORTED";
+        case DT::NEARLY_SORTED:  return "NEARLY_SORTED";
+        case DT::FEW_UNIQUE:     return "FEW_UNIQUE";
+        case DT::PERMUTATION:    return "PERMUTATION";
+        case DT::DISTINCT:       return "DISTINCT";
+        case DT::ORGAN_PIPE:     return "ORGAN_PIPE";
+        case DT::SAWTOOTH:       return "SAWTOOTH";
+        case DT::PUSH_FRONT:     return "PUSH_FRONT";
+        case DT::PUSH_BACK:      return "PUSH_BACK";
+        case DT::ALL_EQUAL:      return "ALL_EQUAL";
+    }
+
+    return "UNKNOWN";
+}
+
+//A value as text
+template <typename T>
+std::string dataset_detail::valueText(const T value)
+{
+    TextFormatter<T> formatter(TextFormat(), 1);
+    std::string text(formatter.widest(), '\0');
+    const char* end = formatter.format(&text[0], &value, 1);
+
+    text.resize(static_cast<size_t>(end - text.data()) - 1);    //Without the closing line break
+    return text;
+}
+
+//A JSON string literal
+inline std::string dataset_detail::jsonText(const std::string& text)
+{
+    std::string quoted = "\"";
+    for(const char c : text)
+    {
+        if (c == '"' or c == '\\')
+            quoted += '\\';
+
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+            quoted += escape;
+        }
+        else
+            quoted += c;
+    }
+
+    return quoted + "\"";
+}
+
+//Keep a value
+template <typename V>
+void doNotOptimize(const V& value) noexcept
+{
+#if defined(__GNUC__) or defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+
+/*
+    +-----------------------------------+
+    |     Benchmark Implementation      |
+    +-----------------------------------+
+*/
+
+
+// ********** SPECIAL MEMBER FUNCTIONS **********
+
+//Constructor
+template <typename T>
+Benchmark<T>::Benchmark(const Sweep<T>& sweep): sweep(sweep) {}
+
+
+// ********** PRIVATE METHODS **********
+
+//Time one configuration
+template <typename T>
+template <DT dataT, typename Function>
+void Benchmark<T>::measure(const std::string& name, Function& function, const Sweep<T>& settings, const size_t size, const T min, const T max)
+{
+    //The work copy: the function runs on it, and it is restored before every run. Prefetching, every run gets its own copy from a pipeline instead
+    //(input s again on each repetition), made while the previous run was timed
+    std::unique_ptr<DynamicDataset<T, dataT>> input;
+    std::unique_ptr<DatasetPipeline<T, dataT>> ring;
+    bool prefetching = settings.prefetch > 0;
+#if defined(DATASET_POSIX_IO)
+    prefetching = prefetching and settings.cache.empty();
+#endif
+    if (prefetching)
+        ring = std::make_unique<DatasetPipeline<T, dataT>>(size, min, max, Parallel{settings.seed, settings.threads}, Prefetch{settings.prefetch + 1, 1, settings.repetitions, settings.seeds * settings.repetitions});
+    else
+        input = std::make_unique<DynamicDataset<T, dataT>>(size, min, max, Parallel{settings.seed, settings.threads});
+    std::vector<double> times, cycles;
+
+    for(size_t s=0; s < settings.seeds; s++)
+    {
+        const Parallel parallel{settings.seed + s, settings.threads};
+#if defined(DATASET_POSIX_IO)
+        std::unique_ptr<DynamicDataset<T, dataT>> cached;
+        if (not settings.cache.empty())
+            cached = std::make_unique<DynamicDataset<T, dataT>>(size, min, max, parallel, Cache{settings.cache});
+#endif
+
+        double fastest = std::numeric_limits<double>::infinity(), fewest = fastest;
+        for(size_t r=0; r < settings.repetitions; r++)
+        {
+            //Restore the input (untimed); validating, regenerated inputs come with their checksum, the others are summed here
+            T* data = ring ? ring->next().get() : input->get();
+            std::uint64_t checksum = 0;
+            bool summed = false;
+#if defined(DATASET_POSIX_IO)
+            if (cached)
+                std::copy(cached->begin(), cached->end(), data);
+            else
+#endif
+            if (not ring and settings.validate)
+            {
+                checksum = input->genNewDataChecked(min, max, parallel);
+                summed = true;
+            }
+            else if (not ring)
+                input->genNewData(min, max, parallel);
+
+            if (settings.validate and not summed)
+                checksum = multisetChecksum(DatasetSpan<const T>(data, size), settings.threads);
+            doNotOptimize(data[0]);
+
+            const auto start = std::chrono::steady_clock::now();
+            const std::uint64_t first = dataset_detail::ticks();
+
+            //Results are kept so the call can't be optimized away
+            if constexpr (std::is_void<std::invoke_result_t<Function&, T*, size_t>>::value)
+                function(data, size);
+            else
+                doNotOptimize(function(data, size));
+            doNotOptimize(data[0]);
+
+            const std::uint64_t last = dataset_detail::ticks();
+            const auto stop = std::chrono::steady_clock::now();
+
+            fastest = std::min(fastest, std::chrono::duration<double, std::nano>(stop - start).count());
+            fewest = std::min(fewest, static_cast<double>(last - first));
+
+            if (settings.validate)
+            {
+                const DatasetSpan<const T> output(data, size);
+                if (not isSorted(output, settings.threads) or multisetChecksum(output, settings.threads) != checksum)
+                    throw std::runtime_error("invalid output; '" + name + "' didn't sort its " + dataset_detail::typeName(dataT) + " input of " + std::to_string(size) + " elements (seed " + std::to_string(parallel.seed) + ").");
+            }
+        }
+
+        times.push_back(fastest / static_cast<double>(size));
+        cycles.push_back(fewest / static_cast<double>(size));
+    }
+
+    //Mean and (sample) standard deviation over the inputs
+    const double count = static_cast<double>(times.size());
+    const double mean = std::accumulate(times.begin(), times.end(), 0.0) / count;
+    double squares = 0;
+    for(const double time : times)
+        squares += (time - mean) * (time - mean);
+
+    BenchmarkResult<T> result;
+    result.name = name;
+    result.size = size;
+    result.type = dataT;
+    result.min = min;
+    result.max = max;
+    result.seeds = times.size();
+    result.nsPerElement = mean;
+    result.deviation = times.size() > 1 ? std::sqrt(squares / (count - 1)) : 0;
+    result.cyclesPerElement = std::accumulate(cycles.begin(), cycles.end(), 0.0) / count;
+    result.elementsPerSecond = mean > 0 ? 1e9 / mean : 0;
+    result.bytesPerSecond = result.elementsPerSecond * sizeof(T);
+    results.push_back(result);
+}
+
+
+// ********** PUBLIC METHODS **********
+
+//Time a function on the default sweep
+template <typename T>
+template <typename Function>
+void Benchmark<T>::run(const std::string& name, Function function)
+{
+    run(name, function, sweep);
+}
+
+//Time a function on a sweep
+template <typename T>
+template <typename Function>
+void Benchmark<T>::run(const std::string& name, Function function, const Sweep<T>& settings)
+{
+    if (settings.seeds == 0 or settings.repetitions == 0)
+        throw std::invalid_argument("invalid sweep; every configuration needs at least one seed and one repetition.");
+
+    //Every size x type x range; the type picks the dataset class
+    for(const size_t size : settings.sizes)
+        for(const DT type : settings.types)
+            for(const std::pair<T, T>& range : settings.ranges)
+            {
+                switch (type)
+                {
+                    case DT::RANDOM:         measure<DT::RANDOM>(name, function, settings, size, range.first, range.second);         break;
+                    case DT::SORTED:         measure<DT::SORTED>(name, function, settings, size, range.first, range.second);         break;
+                    case DT::REVERSE_SORTED: measure<DT::REVERSE_SORTED>(name, function, settings, size, range.first, range.second); break;
+                    case DT::NEARLY_SORTED:  measure<DT::NEARLY_SORTED>(name, function, settings, size, range.first, range.second);  break;
+                    case DT::FEW_UNIQUE:     measure<DT::FEW_UNIQUE>(name, function, settings, size, range.first, range.second);     break;
+                    case DT::ORGAN_PIPE:     measure<DT::ORGAN_PIPE>(name, function, settings, size, range.first, range.second);     break;
+                    case DT::SAWTOOTH:       measure<DT::SAWTOOTH>(name, function, settings, size, range.first, range.second);       break;
+                    case DT::PUSH_FRONT:     measure<DT::PUSH_FRONT>(name, function, settings, size, range.first, range.second);     break;
+                    case DT::PUSH_BACK:      measure<DT::PUSH_BACK>(name, function, settings, size, range.first, range.second);      break;
+                    case DT::ALL_EQUAL:      measure<DT::ALL_EQUAL>(name, function, settings, size, range.first, range.second);      break;
+                    case DT::PERMUTATION:
+                    case DT::DISTINCT:
+                        //(integers only; a permutation's range must hold 'size' values)
+                        if constexpr (dataset_detail::isReal<T>)
+                            throw std::invalid_argument("invalid sweep; PERMUTATION and DISTINCT datasets must be integral.");
+                        else if (type == DT::PERMUTATION)
+                            measure<DT::PERMUTATION>(name, function, settings, size, range.first, range.second);
+                        else
+                            measure<DT::DISTINCT>(name, function, settings, size, range.first, range.second);
+                        break;
+                }
+            }
+}
+
+//The results so far
+template <typename T>
+const std::vector<BenchmarkResult<T>>& Benchmark<T>::report() const noexcept
+{
+    return results;
+}
+
+//Table of the results
+template <typename T>
+void Benchmark<T>::print(std::ostream& out) const
+{
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << std::left << std::setw(24) << "Benchmark" << std::setw(16) << "Type" << std::right << std::setw(12) << "Size" << "  " << std::setw(24) << "Range"
+        << std::setw(14) << "ns/element" << std::setw(12) << "+/-" << std::setw(14) << "ticks/elem" << std::setw(14) << "M elem/s" << "\n";
+
+    out << std::fixed << std::setprecision(3);
+    for(const BenchmarkResult<T>& result : results)
+    {
+        const std::string range = "[" + dataset_detail::valueText(result.min) + ", " + dataset_detail::valueText(result.max) + "]";
+        out << std::left << std::setw(24) << result.name << std::setw(16) << dataset_detail::typeName(result.type) << std::right << std::setw(12) << result.size
+            << "  " << std::setw(24) << range << std::setw(14) << result.nsPerElement << std::setw(12) << result.deviation << std::setw(14) << result.cyclesPerElement
+            << std::setw(14) << result.elementsPerSecond / 1e6 << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+//CSV export
+template <typename T>
+void Benchmark<T>::writeCSV(std::ostream& out) const
+{
+    const std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    out << "name,type,size,min,max,seeds,ns_per_element,deviation,cycles_per_element,elements_per_second,bytes_per_second\n";
+    for(const BenchmarkResult<T>& result : results)
+    {
+        //Names are quoted (doubling any quotes) so commas in them are harmless
+        std::string name = "\"";
+        for(const char c : result.name)
+            name += c == '"' ? std::string("\"\"") : std::string(1, c);
+
+        out << name << "\"," << dataset_detail::typeName(result.type) << "," << result.size << "," << dataset_detail::valueText(result.min) << ","
+            << dataset_detail::valueText(result.max) << "," << result.seeds << "," << result.nsPerElement << "," << result.deviation << ","
+            << result.cyclesPerElement << "," << result.elementsPerSecond << "," << result.bytesPerSecond << "\n";
+    }
+
+    out.precision(precision);
+}
+
+//JSON export
+template <typename T>
+void Benchmark<T>::writeJSON(std::ostream& out) const
+{
+    const std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    out << "{\n  \"benchmarks\": [";
+    for(size_t i=0; i < results.size(); i++)
+    {
+        const BenchmarkResult<T>& result = results[i];
+
+        //Ranges are strings: 128-bit integers don't fit a JSON number
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << dataset_detail::jsonText(result.name) << ", \"type\": \"" << dataset_detail::typeName(result.type)
+            << "\", \"size\": " << result.size << ", \"min\": \"" << dataset_detail::valueText(result.min) << "\", \"max\": \"" << dataset_detail::valueText(result.max)
+            << "\", \"seeds\": " << result.seeds << ", \"ns_per_element\": " << result.nsPerElement << ", \"deviation\": " << result.deviation
+            << ", \"cycles_per_element\": " << result.cyclesPerElement << ", \"elements_per_second\": " << result.elementsPerSecond
+            << ", \"bytes_per_second\": " << result.bytesPerSecond << "}";
+    }
+
+    out << "\n  ]\n}\n";
+    out.precision(precision);
+}
@@ -0,0 +1,361 @@
+/*
+  Version: C++17
+  Compilation Instructions: cmake -S . -B build && cmake --build build, then ./build/generate_dataset (or: g++ -std=c++17 -O2 -pthread -I.. generate_dataset.cpp)
+  Function: generates a dataset whose size, element type, DT, range, seed, engine, threads, NUMA placement and output format are chosen at runtime,
+            and reports how fast it was generated and written (on stderr, so the data can go to stdout)
+
+  Usage examples:
+  ===============
+  'generate_dataset --size 1000000000 --dt SORTED --output sorted.bin' writes 1B sorted integers in [0, 1000] as binary, generated on every core
+  'generate_dataset --size 100000000 --type double --min 0 --max 1 --format text --output -' prints 100M doubles to stdout
+  'generate_dataset --size 10000000000 --type uint64 --max 18446744073709551615 --stream --output huge.bin' streams 80GB to a file in O(1) memory
+  'generate_dataset --size 1000000000 --dt FEW_UNIQUE --format packed --output few.dsp' writes a compressed file (see 'PackedReader')
+  'generate_dataset --size 1000000000 --format cache --output /var/cache/datasets' generates into the dataset cache (created if missing; mapped by later runs)
+  'generate_dataset --size 1000000000 --numa interleave --threads 64' generates on 64 threads into pages spread over every NUMA node
+  'generate_dataset --size 10000000 --engine "xoshiro256**" --seed 7' generates on one thread from xoshiro256** (no output: throughput only)
+  'generate_dataset --size 10000000 --engine wyrand --output random.bin' generates on one thread from WyRand
+*/
+
+#include "dataset.hpp"
+
+#include <chrono>     //Wall-clock timing
+#include <cstdlib>   //Contains 'std::strtoull()', 'std::strtoll()' and 'std::strtold()'
+#include <cerrno>   //Contains 'ERANGE'
+#include <cctype>   //Contains 'std::toupper()'
+#include <filesystem>  //Creates the cache directory
+
+namespace
+{
+    //What to generate and where to put it (every option is a string until the type is known)
+    struct Options
+    {
+        size_t size = 0;                      //Elements (required)
+        std::string type = "int32";          //int32, int64, uint32, uint64, float, double
+        std::string dt = "RANDOM";          //Any 'DT' name
+        std::string min = "0", max = "1000";    //Range, parsed as the element type
+        std::uint64_t seed = 1;
+        std::string engine = "philox";    //'philox' generates Philox streams on every thread; every other engine (see 'USAGE') generates on one thread
+        unsigned threads = 0;            //0 = all cores
+        std::string numa;               //first-touch, interleave, bind:<node> (none = ordinary allocation)
+        std::string format = "binary"; //binary, text, packed, cache
+        std::string output;           //File (- = stdout), or the cache directory (empty = no output)
+        bool stream = false;         //Generate straight to the output through a 'DatasetView' (O(1) memory; RANDOM, sorted and FEW_UNIQUE only)
+        bool direct = false;        //Open the output with 'O_DIRECT'
+    };
+
+    const char* const USAGE = "usage: generate_dataset --size n [--type int32|int64|uint32|uint64|float|double] [--dt RANDOM|SORTED|...] [--min v] [--max v]\n"
+                              "                        [--seed s] [--engine philox|mt19937|xoshiro256**|xoshiro256+|pcg64|wyrand|splitmix64]\n"
+                              "                        [--threads n] [--numa first-touch|interleave|bind:node] [--format binary|text|packed|cache] [--output path|-]\n"
+                              "                        [--stream] [--direct]\n"
+                              "       (--format cache takes the cache directory as --output, and creates it if it doesn't exist)\n";
+
+    const char* const TYPES[] = {"RANDOM", "SORTED", "REVERSE_SORTED", "NEARLY_SORTED", "FEW_UNIQUE", "PERMUTATION", "DISTINCT", "ORGAN_PIPE",
+                                 "SAWTOOTH", "PUSH_FRONT", "PUSH_BACK", "ALL_EQUAL"};    //In 'DT' order
+
+    double since(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    //One line of the report: elements and bytes per second
+    void report(const char* what, const Options& options, const size_t bytes, const double seconds)
+    {
+        std::cerr << std::left << std::setw(10) << what << std::right << options.size << " " << options.type << " " << options.dt << " elements in "
+                  << std::fixed << std::setprecision(3) << seconds << " s (" << std::setprecision(1) << options.size / seconds / 1e6 << " M elem/s, "
+                  << std::setprecision(2) << bytes / seconds / 1e9 << " GB/s)\n";
+    }
+
+    //A number of type T: a range bound, or a size, seed, thread count or node (rejecting anything that isn't wholly a number in T's range)
+    template <typename T>
+    T parse(const std::string& text, const char* name)
+    {
+        char* end = nullptr;
+        errno = 0;
+        T value;
+
+        if constexpr (std::is_floating_point<T>::value)
+            value = static_cast<T>(std::strtold(text.c_str(), &end));
+        else if constexpr (std::is_signed<T>::value)
+        {
+            const long long parsed = std::strtoll(text.c_str(), &end, 10);
+            value = static_cast<T>(parsed);
+            if (static_cast<long long>(value) != parsed)
+                errno = ERANGE;
+        }
+        else
+        {
+            const unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+            value = static_cast<T>(parsed);
+            if (static_cast<unsigned long long>(value) != parsed or text.find('-') != std::string::npos)
+                errno = ERANGE;
+        }
+
+        if (text.empty() or *end != '\0' or errno == ERANGE)
+            throw std::invalid_argument("invalid " + std::string(name) + "; '" + text + "' isn't a number in the range of its type.");
+        return value;
+    }
+
+    Output output(const Options& options, const Format format)
+    {
+        Output settings;
+        settings.format = format;
+        settings.direct = options.direct;
+        return settings;
+    }
+
+    //Write a dataset or a view in the chosen format ('-' is stdout)
+    template <typename Data>
+    void write(const Data& data, const Options& options, const Format format)
+    {
+        if (options.output == "-")
+            data.write(STDOUT_FILENO, output(options, format));
+        else
+            data.write(options.output, output(options, format));
+    }
+
+    Format format(const Options& options)
+    {
+        if (options.format == "binary")
+            return Format::BINARY;
+        if (options.format == "text")
+            return Format::TEXT;
+        if (options.format == "packed")
+            return Format::PACKED;
+        throw std::invalid_argument("invalid format; '" + options.format + "' isn't binary, text, packed or cache.");
+    }
+
+    Numa numa(const Options& options)
+    {
+        if (options.numa == "first-touch")
+            return Numa{Placement::FIRST_TOUCH};
+        if (options.numa == "interleave")
+            return Numa{Placement::INTERLEAVE};
+        if (options.numa.compare(0, 5, "bind:") == 0 and options.numa.size() > 5)
+            return Numa{Placement::BIND, parse<int>(options.numa.substr(5), "NUMA node")};
+        throw std::invalid_argument("invalid NUMA policy; '" + options.numa + "' isn't first-touch, interleave or bind:<node>.");
+    }
+
+    //Stream: each chunk is generated straight into the output buffer, so the dataset never exists in memory
+    template <typename T, DT dataT>
+    void stream(const Options& options, const T min, const T max)
+    {
+        if constexpr (dataT == DT::PERMUTATION or dataT == DT::DISTINCT or dataset_detail::isPattern(dataT))
+            throw std::invalid_argument("invalid option; --stream only generates the RANDOM, sorted and FEW_UNIQUE types.");
+        else
+        {
+            if (options.output.empty() or options.format == "cache" or not options.numa.empty() or options.engine != "philox")
+                throw std::invalid_argument("invalid option; --stream needs a file (binary, text or packed), the philox engine and no NUMA policy.");
+
+            const auto start = std::chrono::steady_clock::now();
+            const DatasetView<T, dataT> view(options.size, min, max, options.seed);
+            write(view, options, format(options));
+            report("streamed", options, options.size * sizeof(T), since(start));
+        }
+    }
+
+    //Report how long generating took, then write the dataset out (a cached dataset is already on disk)
+    template <typename Data>
+    void finish(const Data& data, const Options& options, const std::chrono::steady_clock::time_point start)
+    {
+        const size_t bytes = options.size * sizeof(*data.get());
+        report(options.format == "cache" ? "cached" : "generated", options, bytes, since(start));
+
+        if (options.format == "cache" or options.output.empty())
+            return;
+
+        const auto writing = std::chrono::steady_clock::now();
+        write(data, options, format(options));
+        report("wrote", options, bytes, since(writing));
+    }
+
+    //Every thread, through Philox streams (the dataset's engine is never used)
+    template <typename T, DT dataT>
+    void philox(const Options& options, const T min, const T max)
+    {
+        const Parallel parallel{options.seed, options.threads};
+        const auto start = std::chrono::steady_clock::now();
+
+        if (options.format == "cache")
+            finish(DynamicDataset<T, dataT>(options.size, min, max, parallel, Cache{options.output}), options, start);
+        else if (not options.numa.empty())
+            finish(DynamicDataset<T, dataT>(options.size, min, max, parallel, numa(options)), options, start);
+        else
+            finish(DynamicDataset<T, dataT>(options.size, min, max, parallel), options, start);
+    }
+
+    //One thread, from 'Engine' (each engine compiles a whole set of generators, which is most of the tool's build time)
+    template <typename T, DT dataT, typename Engine>
+    void seeded(const Options& options, const T min, const T max)
+    {
+        if (options.threads > 1 or not options.numa.empty())
+            throw std::invalid_argument("invalid option; only the philox engine generates on several threads or with a NUMA policy.");
+
+        const auto start = std::chrono::steady_clock::now();
+        if (options.format == "cache")
+            finish(DynamicDataset<T, dataT, Engine>(options.size, min, max, options.seed, Cache{options.output}), options, start);
+        else
+            finish(DynamicDataset<T, dataT, Engine>(options.size, min, max, options.seed), options, start);
+    }
+
+    //Pick the engine
+    template <typename T, DT dataT>
+    void generateWith(const Options& options)
+    {
+        const T min = parse<T>(options.min, "minimum"), max = parse<T>(options.max, "maximum");
+        const std::string& engine = options.engine;
+
+        if (options.format == "cache" and (options.output.empty() or not options.numa.empty()))
+            throw std::invalid_argument("invalid option; --format cache needs the cache directory as --output, and no NUMA policy.");
+        if (options.format != "cache")
+            format(options);    //Refuse an unknown format before generating
+        else if (not options.stream)
+            std::filesystem::create_directories(options.output);    //A first run creates the cache (throws 'filesystem_error' if it can't)
+
+        if (options.stream)
+            stream<T, dataT>(options, min, max);
+        else if (engine == "philox")
+            philox<T, dataT>(options, min, max);
+        else if (engine == "mt19937")
+            seeded<T, dataT, std::mt19937>(options, min, max);
+        else if (engine == "xoshiro256**")
+            seeded<T, dataT, Xoshiro256StarStar>(options, min, max);
+        else if (engine == "xoshiro256+")
+            seeded<T, dataT, Xoshiro256Plus>(options, min, max);
+        else if (engine == "pcg64")
+            seeded<T, dataT, Pcg64>(options, min, max);
+        else if (engine == "wyrand")
+            seeded<T, dataT, WyRand>(options, min, max);
+        else if (engine == "splitmix64")
+            seeded<T, dataT, SplitMix64>(options, min, max);
+        else
+            throw std::invalid_argument("invalid engine; '" + engine + "' isn't philox, mt19937, xoshiro256**, xoshiro256+, pcg64, wyrand or splitmix64.");
+    }
+
+    //Integral-only types are refused on floating point
+    template <typename T, DT dataT>
+    void generate(const Options& options)
+    {
+        if constexpr ((dataT == DT::PERMUTATION or dataT == DT::DISTINCT) and std::is_floating_point<T>::value)
+            throw std::invalid_argument("invalid type; PERMUTATION and DISTINCT datasets must be integral.");
+        else
+            generateWith<T, dataT>(options);
+    }
+
+    //Pick the DT
+    template <typename T>
+    void generate(const Options& options)
+    {
+        switch (static_cast<DT>(std::find(std::begin(TYPES), std::end(TYPES), options.dt) - std::begin(TYPES)))
+        {
+            case DT::RANDOM: return generate<T, DT::RANDOM>(options);
+            case DT::SORTED: return generate<T, DT::SORTED>(options);
+            case DT::REVERSE_SORTED: return generate<T, DT::REVERSE_SORTED>(options);
+            case DT::NEARLY_SORTED: return generate<T, DT::NEARLY_SORTED>(options);
+            case DT::FEW_UNIQUE: return generate<T, DT::FEW_UNIQUE>(options);
+            case DT::PERMUTATION: return generate<T, DT::PERMUTATION>(options);
+            case DT::DISTINCT: return generate<T, DT::DISTINCT>(options);
+            case DT::ORGAN_PIPE: return generate<T, DT::ORGAN_PIPE>(options);
+            case DT::SAWTOOTH: return generate<T, DT::SAWTOOTH>(options);
+            case DT::PUSH_FRONT: return generate<T, DT::PUSH_FRONT>(options);
+            case DT::PUSH_BACK: return generate<T, DT::PUSH_BACK>(options);
+            case DT::ALL_EQUAL: return generate<T, DT::ALL_EQUAL>(options);
+        }
+
+        throw std::invalid_argument("invalid DT; '" + options.dt + "' isn't one of RANDOM, SORTED, REVERSE_SORTED... (see 'DT').");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    //Options
+    for(int i=1; i < argc; i++)
+    {
+        const std::string option = argv[i];
+        if (option == "--stream" or option == "--direct")
+        {
+            (option == "--stream" ? options.stream : options.direct) = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+        {
+            std::cerr << USAGE;
+            return 1;
+        }
+
+        //Numbers are parsed strictly: trailing garbage or an overflow is an error, not a silent default
+        const std::string value = argv[++i];
+        try
+        {
+            if (option == "--size")
+                options.size = parse<size_t>(value, "size");
+            else if (option == "--type")
+                options.type = value;
+            else if (option == "--dt")
+            {
+                options.dt = value;
+                std::transform(options.dt.begin(), options.dt.end(), options.dt.begin(), [](const unsigned char c) { return static_cast<char>(std::toupper(c)); });
+            }
+            else if (option == "--min")
+                options.min = value;
+            else if (option == "--max")
+                options.max = value;
+            else if (option == "--seed")
+                options.seed = parse<std::uint64_t>(value, "seed");
+            else if (option == "--engine")
+                options.engine = value;
+            else if (option == "--threads")
+                options.threads = parse<unsigned>(value, "thread count");
+            else if (option == "--numa")
+            {
+                options.numa = value;
+                numa(options);    //Refuse a bad policy or node before generating
+            }
+            else if (option == "--format")
+                options.format = value;
+            else if (option == "--output")
+                options.output = value;
+            else
+            {
+                std::cerr << "unknown option '" << option << "'\n" << USAGE;
+                return 1;
+            }
+        }
+        catch (const std::invalid_argument& error)
+        {
+            std::cerr << "generate_dataset: " << error.what() << "\n" << USAGE;
+            return 1;
+        }
+    }
+
+    if (options.size == 0)
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    try
+    {
+        if (options.type == "int32")
+            generate<std::int32_t>(options);
+        else if (options.type == "int64")
+            generate<std::int64_t>(options);
+        else if (options.type == "uint32")
+            generate<std::uint32_t>(options);
+        else if (options.type == "uint64")
+            generate<std::uint64_t>(options);
+        else if (options.type == "float")
+            generate<float>(options);
+        else if (options.type == "double")
+            generate<double>(options);
+        else
+            throw std::invalid_argument("invalid type; '" + options.type + "' isn't int32, int64, uint32, uint64, float or double.");
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "generate_dataset: " << error.what() << "\n";
+        return 1;
+    }
+}